@@ -76,6 +76,7 @@ SOURCES += \
     $$PWD/algoradyn_info.cpp
 
 include(graph.dyn/graph.dyn.pri)
+include(profiling/profiling.pri)
 include(algorithm/algorithm.pri)
 include(algorithm.reachability.ss/algorithm.reachability.ss.pri)
 include(algorithm.reachability.ss.es/algorithm.reachability.ss.es.pri)
@@ -13,6 +13,13 @@ public:
 
     virtual bool query(Vertex *s, Vertex *t) = 0;
     virtual std::vector<Arc*> queryPath(Vertex *, Vertex *);
+    // query() and queryPath() with their latencies recorded, see recordLatencies()
+    bool timedQuery(Vertex *s, Vertex *t) {
+        return timed(Latency::Query, [this, s, t]() { return query(s, t); });
+    }
+    std::vector<Arc*> timedQueryPath(Vertex *s, Vertex *t) {
+        return timed(Latency::QueryPath, [this, s, t]() { return queryPath(s, t); });
+    }
 };
 
 }
@@ -28,23 +28,23 @@
 
 namespace Algora {
 
-template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust>
+template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust, bool profiling>
 SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<
-                                DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust>
+                                DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust, profiling>
     ::SupportiveVerticesDynamicAllPairsReachabilityAlgorithm(
             double supportSize,
             unsigned long adjustAfter,
             const SingleSourceParameterSet &ssourceParams,
             const SingleSinkParameterSet &ssinkParams)
     : SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<
-        DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust>(
+        DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust, profiling>(
           std::make_pair(supportSize, adjustAfter), ssourceParams, ssinkParams)
 {
 }
 
-template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust>
+template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust, bool profiling>
 SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<
-                                DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust>
+                                DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust, profiling>
     ::SupportiveVerticesDynamicAllPairsReachabilityAlgorithm(
         const ParameterSet &params,
         const SingleSourceParameterSet &ssourceParams,
@@ -57,36 +57,36 @@ SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<
     supportiveVertexToSSRAlgorithm.setDefaultValue({nullptr, nullptr});
 }
 
-template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust>
+template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust, bool profiling>
 SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<
-    DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust>
+    DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust, profiling>
     ::SupportiveVerticesDynamicAllPairsReachabilityAlgorithm(double supportSize,
                                                              unsigned long adjustAfter)
     : SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<
-        DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust>(
+        DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust, profiling>(
           std::make_pair(supportSize, adjustAfter), {}, {})
 { }
 
-template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust>
+template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust, bool profiling>
 SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<
-    DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust>
+    DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust, profiling>
     ::~SupportiveVerticesDynamicAllPairsReachabilityAlgorithm()
 {
     reset();
 }
 
-template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust>
+template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust, bool profiling>
 void
 SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<
-    DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust>
+    DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust, profiling>
 ::setSeed(unsigned long long seed)
 {
     this->seed = seed;
 }
 
-template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust>
+template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust, bool profiling>
 bool SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<
-    DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust>::prepare()
+    DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust, profiling>::prepare()
 {
     if (seed == 0ULL) {
         std::random_device rd;
@@ -98,9 +98,9 @@ bool SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<
     return true;
 }
 
-template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust>
+template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust, bool profiling>
 void SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<
-    DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust>::run()
+    DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust, profiling>::run()
 {
     if (initialized) {
         return;
@@ -116,8 +116,8 @@ void SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<
     }
 }
 
-template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust>
-std::string SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust>::getName()
+template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust, bool profiling>
+std::string SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust, profiling>::getName()
 const noexcept
 {
     DynamicSingleSourceAlgorithm ssrc(ssourceParameters);
@@ -135,8 +135,8 @@ const noexcept
     return ss.str();
 }
 
-template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust>
-std::string SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust>
+template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust, bool profiling>
+std::string SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust, profiling>
     ::getShortName() const noexcept
 {
     DynamicSingleSourceAlgorithm ssrc(ssourceParameters);
@@ -154,32 +154,32 @@ std::string SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<DynamicSingle
     return ss.str();
 }
 
-template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust>
+template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust, bool profiling>
 std::string
-SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust>::getProfilingInfo()
+SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust, profiling>::getProfilingInfo()
 const
 {
     std::stringstream ss;
     ss << "Seed:                         " << seed << std::endl;
-#ifdef COLLECT_PR_DATA
-    ss << "#vertices considered:         " << pr_consideredVertices << std::endl;
-    ss << "#arcs considered:             " << pr_consideredArcs << std::endl;
-    ss << "#supportive vertices (min):   " << min_supportive_vertices << std::endl;
-    ss << "#supportive vertices (max):   " << max_supportive_vertices << std::endl;
-    ss << "#trivial queries:             " << num_trivial_queries << std::endl;
-    ss << "#SSR-only queries:            " << num_only_ssr_queries << std::endl;
-    ss << "#Support-only queries (svt):  " << num_only_support_queries_svt << std::endl;
-    ss << "#Support-only queries (vs):   " << num_only_support_queries_vs << std::endl;
-    ss << "#Support-only queries (tv):   " << num_only_support_queries_tv << std::endl;
-    ss << "#Expensive queries:           " << num_expensive_queries << std::endl;
-    ss << "#Adjustments:                 " << num_adjustments << std::endl;
-#endif
+    if constexpr (profiling) {
+        ss << "#vertices considered:         " << pr_consideredVertices << std::endl;
+        ss << "#arcs considered:             " << pr_consideredArcs << std::endl;
+        ss << "#supportive vertices (min):   " << counters.min_supportive_vertices << std::endl;
+        ss << "#supportive vertices (max):   " << counters.max_supportive_vertices << std::endl;
+        ss << "#trivial queries:             " << counters.num_trivial_queries << std::endl;
+        ss << "#SSR-only queries:            " << counters.num_only_ssr_queries << std::endl;
+        ss << "#Support-only queries (svt):  " << counters.num_only_support_queries_svt << std::endl;
+        ss << "#Support-only queries (vs):   " << counters.num_only_support_queries_vs << std::endl;
+        ss << "#Support-only queries (tv):   " << counters.num_only_support_queries_tv << std::endl;
+        ss << "#Expensive queries:           " << counters.num_expensive_queries << std::endl;
+        ss << "#Adjustments:                 " << counters.num_adjustments << std::endl;
+    }
     return ss.str();
 }
 
-template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust>
+template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust, bool profiling>
 void SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<DynamicSingleSourceAlgorithm,
-                                                            DynamicSingleSinkAlgorithm, reAdjust>
+                                                            DynamicSingleSinkAlgorithm, reAdjust, profiling>
     ::onVertexAdd(Vertex *v)
 {
     PRINT_DEBUG("A vertex has been added: " << v);
@@ -191,17 +191,12 @@ void SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<DynamicSingleSourceA
 
     // vertex is isolated
 
-    if (!doesAutoUpdate()) {
-        for (auto &[ssrc, ssink] : supportiveSSRAlgorithms) {
-            ssrc->onVertexAdd(v);
-            ssink->onVertexAdd(v);
-        }
-    }
+    supportiveSSRGroup.onVertexAdd(v);
 }
 
-template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust>
+template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust, bool profiling>
 void SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<
-                                DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust>
+                                DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust, profiling>
     ::onVertexRemove(Vertex *v)
 {
     PRINT_DEBUG("A vertex is about to be deleted: " << v);
@@ -220,21 +215,16 @@ void SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<
         pickSupport = true;
     }
 
-    if (!doesAutoUpdate()) {
-        for (auto &[ssrc, ssink] : supportiveSSRAlgorithms) {
-            ssrc->onVertexRemove(v);
-            ssink->onVertexRemove(v);
-        }
-    }
+    supportiveSSRGroup.onVertexRemove(v);
 
     if (pickSupport) {
         pickSupportVertices(false);
     }
 }
 
-template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust>
+template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust, bool profiling>
 void SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<
-    DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust>::onArcAdd(Arc *a)
+    DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust, profiling>::onArcAdd(Arc *a)
 {
     PRINT_DEBUG("An arc has been added: " << a);
     DynamicDiGraphAlgorithm::onArcAdd(a);
@@ -253,18 +243,15 @@ void SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<
         }
     }
 
-    if (!doesAutoUpdate() && !readjusted) {
-        for (auto &[ssrc, ssink] : supportiveSSRAlgorithms) {
-            ssrc->onArcAdd(a);
-            ssink->onArcAdd(a);
-        }
+    if (!readjusted) {
+        supportiveSSRGroup.onArcAdd(a);
     }
 
 }
 
-template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust>
+template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust, bool profiling>
 void SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<
-    DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust>::onArcRemove(Arc *a)
+    DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust, profiling>::onArcRemove(Arc *a)
 {
     PRINT_DEBUG("An arc is about to be deleted: " << a);
     DynamicDiGraphAlgorithm::onArcRemove(a);
@@ -284,100 +271,102 @@ void SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<
         }
     }
 
-    if (!doesAutoUpdate() && !readjusted) {
-        for (auto &[ssrc, ssink] : supportiveSSRAlgorithms) {
-            ssrc->onArcRemove(a);
-            ssink->onArcRemove(a);
-        }
+    if (!readjusted) {
+        supportiveSSRGroup.onArcRemove(a);
     }
 }
 
-template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust>
+template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust, bool profiling>
 DynamicDiGraphAlgorithm::Profile
 SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<
-        DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust>::getProfile() const
+        DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust, profiling>::getProfile() const
 {
     auto profile = DynamicAllPairsReachabilityAlgorithm::getProfile();
     profile.push_back(std::make_pair(std::string("seed"),
                                      seed));
-    profile.push_back(std::make_pair(std::string("min_supportive_ssr"),
-                                     min_supportive_vertices));
-    profile.push_back(std::make_pair(std::string("max_supportive_ssr"),
-                                     max_supportive_vertices));
-    profile.push_back(std::make_pair(std::string("num_trivial_queries"),
-                                     num_trivial_queries));
-    profile.push_back(std::make_pair(std::string("num_ssr_only_queries"),
-                                     num_only_ssr_queries));
-    profile.push_back(std::make_pair(std::string("num_support_only_queries_svt"),
-                                     num_only_support_queries_svt));
-    profile.push_back(std::make_pair(std::string("num_support_only_queries_vs"),
-                                     num_only_support_queries_vs));
-    profile.push_back(std::make_pair(std::string("num_support_only_queries_tv"),
-                                     num_only_support_queries_tv));
-    profile.push_back(std::make_pair(std::string("num_expensive_queries"),
-                                     num_expensive_queries));
-    profile.push_back(std::make_pair(std::string("num_adjustments"),
-                                     num_adjustments));
+    if constexpr (profiling) {
+        profile.push_back(std::make_pair(std::string("min_supportive_ssr"),
+                                         counters.min_supportive_vertices));
+        profile.push_back(std::make_pair(std::string("max_supportive_ssr"),
+                                         counters.max_supportive_vertices));
+        profile.push_back(std::make_pair(std::string("num_trivial_queries"),
+                                         counters.num_trivial_queries));
+        profile.push_back(std::make_pair(std::string("num_ssr_only_queries"),
+                                         counters.num_only_ssr_queries));
+        profile.push_back(std::make_pair(std::string("num_support_only_queries_svt"),
+                                         counters.num_only_support_queries_svt));
+        profile.push_back(std::make_pair(std::string("num_support_only_queries_vs"),
+                                         counters.num_only_support_queries_vs));
+        profile.push_back(std::make_pair(std::string("num_support_only_queries_tv"),
+                                         counters.num_only_support_queries_tv));
+        profile.push_back(std::make_pair(std::string("num_expensive_queries"),
+                                         counters.num_expensive_queries));
+        profile.push_back(std::make_pair(std::string("num_adjustments"),
+                                         counters.num_adjustments));
+    }
 
     return profile;
 }
 
-template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust>
+template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust, bool profiling>
 void SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<
-            DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust>::onDiGraphSet()
+            DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust, profiling>::onDiGraphSet()
 {
     DynamicAllPairsReachabilityAlgorithm::onDiGraphSet();
 
-    min_supportive_vertices = 0;
-    max_supportive_vertices = 0;
-    num_trivial_queries = 0;
-    num_only_ssr_queries = 0;
-    num_only_support_queries_svt = 0;
-    num_only_support_queries_vs = 0;
-    num_only_support_queries_tv = 0;
-    num_expensive_queries = 0;
+    if constexpr (profiling) {
+        counters = Counters();
+    }
 }
 
-template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust>
+template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust, bool profiling>
 void SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<
-            DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust>::onDiGraphUnset()
+            DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust, profiling>::onDiGraphUnset()
 {
     reset();
     DynamicAllPairsReachabilityAlgorithm::onDiGraphUnset();
 }
 
-template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust>
+template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust, bool profiling>
+void SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<
+            DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust, profiling>::onGraphRebuildBegin()
+{
+    // the subalgorithms refer to the former vertices
+    reset();
+}
+
+template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust, bool profiling>
 bool SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<
-    DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust>::query(Vertex *s, Vertex *t)
+    DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust, profiling>::query(Vertex *s, Vertex *t)
 {
     PRINT_DEBUG("Processing reachability query " << s << " -> " << t << "...");
     if (s == t) {
-#ifdef COLLECT_PR_DATA
-        num_trivial_queries++;
-#endif
+        if constexpr (profiling) {
+            counters.num_trivial_queries++;
+        }
         PRINT_DEBUG("  Same vertices, trivially true.");
         return true;
     }
     if (diGraph->isSink(s) || diGraph->isSource(t)) {
-#ifdef COLLECT_PR_DATA
-        num_trivial_queries++;
-#endif
+        if constexpr (profiling) {
+            counters.num_trivial_queries++;
+        }
         PRINT_DEBUG("  Source is sink or target is source, trivially false.");
         return false;
     }
 
     if (supportiveVertexToSSRAlgorithm[s].first) {
-#ifdef COLLECT_PR_DATA
-        num_only_ssr_queries++;
-#endif
+        if constexpr (profiling) {
+            counters.num_only_ssr_queries++;
+        }
         PRINT_DEBUG("  Source is supportive vertex.");
         return supportiveVertexToSSRAlgorithm[s].first->query(t);
     }
 
     if (supportiveVertexToSSRAlgorithm[t].second) {
-#ifdef COLLECT_PR_DATA
-        num_only_ssr_queries++;
-#endif
+        if constexpr (profiling) {
+            counters.num_only_ssr_queries++;
+        }
         PRINT_DEBUG("  Sink is supportive vertex.");
         return supportiveVertexToSSRAlgorithm[t].second->query(s);
     }
@@ -387,36 +376,36 @@ bool SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<
         auto sv = ssink->query(s);
         if (sv) {
             if (vt) {
-#ifdef COLLECT_PR_DATA
-                num_only_support_queries_svt++;
-#endif
+                if constexpr (profiling) {
+                    counters.num_only_support_queries_svt++;
+                }
                 PRINT_DEBUG("  Reachability established via supportive vertex "
                             << ssrc->getSource() <<  ".");
                 return true;
             }
         } else if (ssink->query(t)) {
             // no path from s to v, but from t to v
-#ifdef COLLECT_PR_DATA
-                num_only_support_queries_tv++;
-#endif
+                if constexpr (profiling) {
+                    counters.num_only_support_queries_tv++;
+                }
                 PRINT_DEBUG("  Non-reachability established via supportive vertex "
                             << ssrc->getSource() <<  ".");
                 return false;
         }
         if (!vt && ssrc->query(s)) {
             // no path from v to t, but from v to s
-#ifdef COLLECT_PR_DATA
-                num_only_support_queries_vs++;
-#endif
+                if constexpr (profiling) {
+                    counters.num_only_support_queries_vs++;
+                }
                 PRINT_DEBUG("  Non-reachability established via supportive vertex "
                             << ssrc->getSource() <<  ".");
                 return false;
         }
     }
 
-#ifdef COLLECT_PR_DATA
-                num_expensive_queries++;
-#endif
+                if constexpr (profiling) {
+                    counters.num_expensive_queries++;
+                }
     // start two-way BFS
     FindDiPathAlgorithm<FastPropertyMap> fpa;
     fpa.setGraph(diGraph);
@@ -427,41 +416,41 @@ bool SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<
     return fpa.deliver();
 }
 
-template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust>
+template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust, bool profiling>
 std::vector<Arc *> SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<
-    DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust>
+    DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust, profiling>
     ::queryPath(Vertex *s, Vertex *t)
 {
     auto emptyPath = std::vector<Arc*>();
 
     PRINT_DEBUG("Processing reachability path query " << s << " -> " << t << "...");
     if (s == t) {
-#ifdef COLLECT_PR_DATA
-        num_trivial_queries++;
-#endif
+        if constexpr (profiling) {
+            counters.num_trivial_queries++;
+        }
         PRINT_DEBUG("  Same vertices, return empty path.");
         return emptyPath;
     }
     if (diGraph->isSink(s) || diGraph->isSource(t)) {
-#ifdef COLLECT_PR_DATA
-        num_trivial_queries++;
-#endif
+        if constexpr (profiling) {
+            counters.num_trivial_queries++;
+        }
         PRINT_DEBUG("  Source is sink or target is source, trivially no path, return empty path.");
         return emptyPath;
     }
 
     if (supportiveVertexToSSRAlgorithm[s].first) {
-#ifdef COLLECT_PR_DATA
-        num_only_ssr_queries++;
-#endif
+        if constexpr (profiling) {
+            counters.num_only_ssr_queries++;
+        }
         PRINT_DEBUG("  Source is supportive vertex.");
         return supportiveVertexToSSRAlgorithm[s].first->queryPath(t);
     }
 
     if (supportiveVertexToSSRAlgorithm[t].second) {
-#ifdef COLLECT_PR_DATA
-        num_only_ssr_queries++;
-#endif
+        if constexpr (profiling) {
+            counters.num_only_ssr_queries++;
+        }
         PRINT_DEBUG("  Sink is supportive vertex.");
         return supportiveVertexToSSRAlgorithm[t].second->queryPath(s);
     }
@@ -471,9 +460,9 @@ std::vector<Arc *> SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<
         auto sv = ssink->query(s);
         if (sv) {
             if (vt) {
-#ifdef COLLECT_PR_DATA
-                num_only_support_queries_svt++;
-#endif
+                if constexpr (profiling) {
+                    counters.num_only_support_queries_svt++;
+                }
                 PRINT_DEBUG("  Reachability established via supportive vertex "
                             << ssrc->getSource() <<  ".");
                 auto svPath = ssink->queryPath(s);
@@ -483,27 +472,27 @@ std::vector<Arc *> SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<
             }
         } else if (ssink->query(t)) {
             // no path from s to v, but from t to v
-#ifdef COLLECT_PR_DATA
-                num_only_support_queries_tv++;
-#endif
+                if constexpr (profiling) {
+                    counters.num_only_support_queries_tv++;
+                }
                 PRINT_DEBUG("  Non-reachability established via supportive vertex "
                             << ssrc->getSource() <<  ".");
                 return emptyPath;
         }
         if (!vt && ssrc->query(s)) {
             // no path from v to t, but from v to s
-#ifdef COLLECT_PR_DATA
-                num_only_support_queries_vs++;
-#endif
+                if constexpr (profiling) {
+                    counters.num_only_support_queries_vs++;
+                }
                 PRINT_DEBUG("  Non-reachability established via supportive vertex "
                             << ssrc->getSource() <<  ".");
                 return emptyPath;
         }
     }
 
-#ifdef COLLECT_PR_DATA
-                num_expensive_queries++;
-#endif
+                if constexpr (profiling) {
+                    counters.num_expensive_queries++;
+                }
     // start two-way BFS
     FindDiPathAlgorithm<FastPropertyMap> fpa;
     fpa.setGraph(diGraph);
@@ -517,14 +506,15 @@ std::vector<Arc *> SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<
     return emptyPath;
 }
 
-template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust>
+template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust, bool profiling>
 void SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<
-    DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust>::reset()
+    DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust, profiling>::reset()
 {
     if (!initialized) {
         return;
     }
 
+    supportiveSSRGroup.clear();
     for (auto &[ssrc, ssink] : supportiveSSRAlgorithms) {
         delete ssrc;
         delete ssink;
@@ -534,10 +524,10 @@ void SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<
     initialized = false;
 }
 
-template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust>
+template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust, bool profiling>
 void
 SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<
-    DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust>
+    DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust, profiling>
     ::removeSupportiveVertex(Vertex *v)
 {
     auto ssrPair = supportiveVertexToSSRAlgorithm(v);
@@ -559,14 +549,16 @@ SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<
         }
     }
 
+    supportiveSSRGroup.remove(ssrPair.first);
+    supportiveSSRGroup.remove(ssrPair.second);
     delete ssrPair.first;
     delete ssrPair.second;
     supportiveVertexToSSRAlgorithm.resetToDefault(v);
 }
 
-template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust>
+template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust, bool profiling>
 void SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<
-    DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust>::pickSupportVertices(
+    DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust, profiling>::pickSupportVertices(
         bool adjust)
 {
 
@@ -619,6 +611,7 @@ void SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<
                 && supportiveVertexToSSRAlgorithm.size() < diGraph->getSize()) {
             supportiveVertexToSSRAlgorithm.resetAll(diGraph->getSize());
         }
+        supportiveSSRGroup.clear();
         for (auto &[ssrc, ssink] : supportiveSSRAlgorithms) {
             supportiveVertexToSSRAlgorithm.resetToDefault(ssrc->getSource());
             delete ssrc;
@@ -627,20 +620,24 @@ void SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<
         supportiveSSRAlgorithms.clear();
 
         pickVertices(numSupportiveVertices);
-        num_adjustments++;
+        if constexpr (profiling) {
+            counters.num_adjustments++;
+        }
     }
 
-    if (supportiveSSRAlgorithms.size() < min_supportive_vertices) {
-        min_supportive_vertices = supportiveSSRAlgorithms.size();
-    }
-    if (supportiveSSRAlgorithms.size() > max_supportive_vertices) {
-        max_supportive_vertices = supportiveSSRAlgorithms.size();
+    if constexpr (profiling) {
+        if (supportiveSSRAlgorithms.size() < counters.min_supportive_vertices) {
+            counters.min_supportive_vertices = supportiveSSRAlgorithms.size();
+        }
+        if (supportiveSSRAlgorithms.size() > counters.max_supportive_vertices) {
+            counters.max_supportive_vertices = supportiveSSRAlgorithms.size();
+        }
     }
 }
 
-template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust>
+template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust, bool profiling>
 void SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<
-    DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust>
+    DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust, profiling>
     ::createAndInitAlgorithm(Vertex *v)
 {
     assert(supportiveVertexToSSRAlgorithm(v) == supportiveVertexToSSRAlgorithm.getDefaultValue());
@@ -648,11 +645,11 @@ void SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<
     auto *ssrcAlgorithm = new DynamicSingleSourceAlgorithm(ssourceParameters);
     auto *ssinkAlgorithm = new DynamicSingleSinkAlgorithm(ssinkParameters);
 
-    ssrcAlgorithm->setAutoUpdate(this->doesAutoUpdate());
+    supportiveSSRGroup.add(ssrcAlgorithm);
     ssrcAlgorithm->setGraph(diGraph);
     ssrcAlgorithm->setSource(v);
 
-    ssinkAlgorithm->setAutoUpdate(this->doesAutoUpdate());
+    supportiveSSRGroup.add(ssinkAlgorithm);
     ssinkAlgorithm->setGraph(diGraph);
     ssinkAlgorithm->setSource(v);
 
@@ -3,7 +3,9 @@
 #define SUPPORTIVEVERTICESDYNAMICALLPAIRSREACHABILITYALGORITHM_H
 
 #include "dynamicallpairsreachabilityalgorithm.h"
+#include "algorithm/dynamicdigraphalgorithmgroup.h"
 #include "property/fastpropertymap.h"
+#include "profiling/profiling.h"
 #include "graph/digraph.h"
 
 #include <random>
@@ -11,7 +13,7 @@
 namespace Algora {
 
 template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm,
-         bool reAdjust = false>
+         bool reAdjust = false, bool profiling = Profiling::Default>
 class SupportiveVerticesDynamicAllPairsReachabilityAlgorithm
         : public DynamicAllPairsReachabilityAlgorithm
 {
@@ -63,6 +65,10 @@ protected:
     virtual void onDiGraphSet() override;
     virtual void onDiGraphUnset() override;
 
+    // DynamicDiGraphAlgorithm interface
+protected:
+    virtual void onGraphRebuildBegin() override;
+
     // own
 protected:
     double supportSize;
@@ -75,19 +81,25 @@ protected:
     typedef std::pair<DynamicSingleSourceAlgorithm*,DynamicSingleSinkAlgorithm*> SSRPair;
     FastPropertyMap<SSRPair> supportiveVertexToSSRAlgorithm;
     std::vector<SSRPair> supportiveSSRAlgorithms;
+    // passes changes on to the subalgorithms, which do not observe the graph themselves
+    DynamicDiGraphAlgorithmGroup<DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm>
+        supportiveSSRGroup;
     DiGraph::size_type twoWayStepSize;
     bool initialized;
     std::mt19937_64 gen;
 
-    profiling_counter min_supportive_vertices = 0;
-    profiling_counter max_supportive_vertices = 0;
-    profiling_counter num_trivial_queries = 0;
-    profiling_counter num_only_ssr_queries = 0;
-    profiling_counter num_only_support_queries_svt = 0;
-    profiling_counter num_only_support_queries_vs = 0;
-    profiling_counter num_only_support_queries_tv = 0;
-    profiling_counter num_expensive_queries = 0;
-    profiling_counter num_adjustments = 0;
+    struct Counters {
+        profiling_counter min_supportive_vertices = 0;
+        profiling_counter max_supportive_vertices = 0;
+        profiling_counter num_trivial_queries = 0;
+        profiling_counter num_only_ssr_queries = 0;
+        profiling_counter num_only_support_queries_svt = 0;
+        profiling_counter num_only_support_queries_vs = 0;
+        profiling_counter num_only_support_queries_tv = 0;
+        profiling_counter num_expensive_queries = 0;
+        profiling_counter num_adjustments = 0;
+    };
+    [[no_unique_address]] Profiling::Storage<profiling, Counters> counters;
 
     void createAndInitAlgorithm(Vertex *v);
     void reset();
@@ -23,18 +23,18 @@
 
 namespace Algora {
 
-template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust>
+template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust, bool profiling>
 SupportiveVerticesSloppySCCsAPRAlgorithm<
-                DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust>
+                DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust, profiling>
     ::SupportiveVerticesSloppySCCsAPRAlgorithm(double supportSize, unsigned long adjustAfter)
     : Super(supportSize, adjustAfter)
 {
     vertexToSCCRepresentative.setDefaultValue(nullptr);
 }
 
-template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust>
+template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust, bool profiling>
 SupportiveVerticesSloppySCCsAPRAlgorithm<
-                DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust>
+                DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust, profiling>
     ::SupportiveVerticesSloppySCCsAPRAlgorithm(double supportSize, unsigned long adjustAfter,
                                 const typename Super::SingleSourceParameterSet &ssourceParams,
                                 const typename Super::SingleSinkParameterSet &ssinkParams)
@@ -43,9 +43,9 @@ SupportiveVerticesSloppySCCsAPRAlgorithm<
     vertexToSCCRepresentative.setDefaultValue(nullptr);
 }
 
-template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust>
+template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust, bool profiling>
 SupportiveVerticesSloppySCCsAPRAlgorithm<
-                DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust>
+                DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust, profiling>
     ::SupportiveVerticesSloppySCCsAPRAlgorithm(
         const typename Super::ParameterSet &params,
         const typename Super::SingleSourceParameterSet &ssourceParams,
@@ -55,10 +55,10 @@ SupportiveVerticesSloppySCCsAPRAlgorithm<
     vertexToSCCRepresentative.setDefaultValue(nullptr);
 }
 
-template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust>
+template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust, bool profiling>
 void
 SupportiveVerticesSloppySCCsAPRAlgorithm<
-                DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust>
+                DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust, profiling>
     ::run()
 {
     if (this->initialized) {
@@ -75,10 +75,10 @@ SupportiveVerticesSloppySCCsAPRAlgorithm<
     }
 }
 
-template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust>
+template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust, bool profiling>
 std::string
 SupportiveVerticesSloppySCCsAPRAlgorithm<
-                DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust>
+                DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust, profiling>
     ::getName() const noexcept
 {
     DynamicSingleSourceAlgorithm ssrc(this->ssourceParameters);
@@ -96,10 +96,10 @@ SupportiveVerticesSloppySCCsAPRAlgorithm<
     return ss.str();
 }
 
-template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust>
+template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust, bool profiling>
 std::string
 SupportiveVerticesSloppySCCsAPRAlgorithm<
-                DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust>
+                DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust, profiling>
     ::getShortName() const noexcept
 {
     DynamicSingleSourceAlgorithm ssrc(this->ssourceParameters);
@@ -117,37 +117,37 @@ SupportiveVerticesSloppySCCsAPRAlgorithm<
     return ss.str();
 }
 
-template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust>
+template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust, bool profiling>
 std::string
 SupportiveVerticesSloppySCCsAPRAlgorithm<
-                DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust>
+                DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust, profiling>
     ::getProfilingInfo() const
 {
     std::stringstream ss;
     ss << "Seed:                         " << this->seed << std::endl;
-#ifdef COLLECT_PR_DATA
-    ss << "#vertices considered:         " << this->pr_consideredVertices << std::endl;
-    ss << "#arcs considered:             " << this->pr_consideredArcs << std::endl;
-    ss << "#supportive vertices (min):   " << this->min_supportive_vertices << std::endl;
-    ss << "#supportive vertices (max):   " << this->max_supportive_vertices << std::endl;
-    ss << "#trivial queries:             " << this->num_trivial_queries << std::endl;
-    ss << "#SSR-only queries:            " << this->num_only_ssr_queries << std::endl;
-    ss << "#SCC queries (via s-rep):     " << this->num_scc_via_srep_queries << std::endl;
-    ss << "#SCC queries (via t-rep):     " << this->num_scc_via_trep_queries << std::endl;
-    ss << "#Support-only queries (svt):  " << this->num_only_support_queries_svt << std::endl;
-    ss << "#Support-only queries (vs):   " << this->num_only_support_queries_vs << std::endl;
-    ss << "#Support-only queries (tv):   " << this->num_only_support_queries_tv << std::endl;
-    ss << "#Expensive queries:           " << this->num_expensive_queries << std::endl;
-    ss << "#Adjustments:                 " << this->num_adjustments << std::endl;
-#endif
+    if constexpr (profiling) {
+        ss << "#vertices considered:         " << this->pr_consideredVertices << std::endl;
+        ss << "#arcs considered:             " << this->pr_consideredArcs << std::endl;
+        ss << "#supportive vertices (min):   " << this->counters.min_supportive_vertices << std::endl;
+        ss << "#supportive vertices (max):   " << this->counters.max_supportive_vertices << std::endl;
+        ss << "#trivial queries:             " << this->counters.num_trivial_queries << std::endl;
+        ss << "#SSR-only queries:            " << this->counters.num_only_ssr_queries << std::endl;
+        ss << "#SCC queries (via s-rep):     " << this->sccCounters.num_scc_via_srep_queries << std::endl;
+        ss << "#SCC queries (via t-rep):     " << this->sccCounters.num_scc_via_trep_queries << std::endl;
+        ss << "#Support-only queries (svt):  " << this->counters.num_only_support_queries_svt << std::endl;
+        ss << "#Support-only queries (vs):   " << this->counters.num_only_support_queries_vs << std::endl;
+        ss << "#Support-only queries (tv):   " << this->counters.num_only_support_queries_tv << std::endl;
+        ss << "#Expensive queries:           " << this->counters.num_expensive_queries << std::endl;
+        ss << "#Adjustments:                 " << this->counters.num_adjustments << std::endl;
+    }
     return ss.str();
 
 }
 
-template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust>
+template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust, bool profiling>
 void
 SupportiveVerticesSloppySCCsAPRAlgorithm<
-                DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust>
+                DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust, profiling>
     ::onVertexAdd(Vertex *v)
 {
     PRINT_DEBUG("A vertex has been added: " << v)
@@ -160,18 +160,13 @@ SupportiveVerticesSloppySCCsAPRAlgorithm<
     // vertex is singleton, cannot be supportive
     assert(this->vertexToSCCRepresentative.hasDefaultValue(v));
 
-    if (!this->doesAutoUpdate()) {
-        for (auto &[ssrc, ssink] : this->supportiveSSRAlgorithms) {
-            ssrc->onVertexAdd(v);
-            ssink->onVertexAdd(v);
-        }
-    }
+    this->supportiveSSRGroup.onVertexAdd(v);
 }
 
-template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust>
+template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust, bool profiling>
 void
 SupportiveVerticesSloppySCCsAPRAlgorithm<
-                DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust>
+                DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust, profiling>
     ::onVertexRemove(Vertex *v)
 {
     PRINT_DEBUG("A vertex is about to be deleted: " << v)
@@ -185,18 +180,13 @@ SupportiveVerticesSloppySCCsAPRAlgorithm<
         this->removeSupportiveVertex(v);
     }
 
-    if (!this->doesAutoUpdate()) {
-        for (auto &[ssrc, ssink] : this->supportiveSSRAlgorithms) {
-            ssrc->onVertexRemove(v);
-            ssink->onVertexRemove(v);
-        }
-    }
+    this->supportiveSSRGroup.onVertexRemove(v);
 }
 
-template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust>
+template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust, bool profiling>
 void
 SupportiveVerticesSloppySCCsAPRAlgorithm<
-                DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust>
+                DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust, profiling>
     ::onArcAdd(Arc *a)
 {
     PRINT_DEBUG("An arc has been added: " << a)
@@ -206,12 +196,7 @@ SupportiveVerticesSloppySCCsAPRAlgorithm<
         return;
     }
 
-    if (!this->doesAutoUpdate()) {
-        for (auto &[ssrc, ssink] : this->supportiveSSRAlgorithms) {
-            ssrc->onArcAdd(a);
-            ssink->onArcAdd(a);
-        }
-    }
+    this->supportiveSSRGroup.onArcAdd(a);
 
     if (reAdjust && this->adjustAfter > 0) {
         this->adjustmentCountUp++;
@@ -222,10 +207,10 @@ SupportiveVerticesSloppySCCsAPRAlgorithm<
     }
 }
 
-template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust>
+template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust, bool profiling>
 void
 SupportiveVerticesSloppySCCsAPRAlgorithm<
-                DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust>
+                DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust, profiling>
     ::onArcRemove(Arc *a)
 {
     PRINT_DEBUG("An arc is about to be deleted: " << a)
@@ -235,12 +220,7 @@ SupportiveVerticesSloppySCCsAPRAlgorithm<
         return;
     }
 
-    if (!this->doesAutoUpdate()) {
-        for (auto &[ssrc, ssink] : this->supportiveSSRAlgorithms) {
-            ssrc->onArcRemove(a);
-            ssink->onArcRemove(a);
-        }
-    }
+    this->supportiveSSRGroup.onArcRemove(a);
 
     if (reAdjust && this->adjustAfter > 0) {
         this->adjustmentCountUp++;
@@ -251,56 +231,58 @@ SupportiveVerticesSloppySCCsAPRAlgorithm<
     }
 }
 
-template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust>
+template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust, bool profiling>
 typename SupportiveVerticesSloppySCCsAPRAlgorithm<
-                DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust>::Super::Profile
+                DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust, profiling>::Super::Profile
 SupportiveVerticesSloppySCCsAPRAlgorithm<
-                DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust>
+                DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust, profiling>
     ::getProfile() const
 {
     auto profile = Super::getProfile();
 
-    profile.push_back(std::make_pair(std::string("num_scc_via_srep_queries"),
-                                     num_scc_via_srep_queries));
-    profile.push_back(std::make_pair(std::string("num_scc_via_trep_queries"),
-                                     num_scc_via_trep_queries));
+    if constexpr (profiling) {
+        profile.push_back(std::make_pair(std::string("num_scc_via_srep_queries"),
+                                         sccCounters.num_scc_via_srep_queries));
+        profile.push_back(std::make_pair(std::string("num_scc_via_trep_queries"),
+                                         sccCounters.num_scc_via_trep_queries));
+    }
     return profile;
 }
 
-template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust>
+template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust, bool profiling>
 bool
 SupportiveVerticesSloppySCCsAPRAlgorithm<
-                DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust>
+                DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust, profiling>
     ::query(Vertex *s, Vertex *t)
 {
     PRINT_DEBUG("Processing reachability query " << s << " -> " << t << "...")
     if (s == t) {
-#ifdef COLLECT_PR_DATA
-        this->num_trivial_queries++;
-#endif
+        if constexpr (profiling) {
+            this->counters.num_trivial_queries++;
+        }
         PRINT_DEBUG("  Same vertices, trivially true.")
         return true;
     }
     if (this->diGraph->isSink(s) || this->diGraph->isSource(t)) {
-#ifdef COLLECT_PR_DATA
-        this->num_trivial_queries++;
-#endif
+        if constexpr (profiling) {
+            this->counters.num_trivial_queries++;
+        }
         PRINT_DEBUG("  Source is sink or target is source, trivially false.")
         return false;
     }
 
     if (this->supportiveVertexToSSRAlgorithm[s].first) {
-#ifdef COLLECT_PR_DATA
-        this->num_only_ssr_queries++;
-#endif
+        if constexpr (profiling) {
+            this->counters.num_only_ssr_queries++;
+        }
         PRINT_DEBUG("  Source is supportive vertex.")
         return this->supportiveVertexToSSRAlgorithm[s].first->query(t);
     }
 
     if (this->supportiveVertexToSSRAlgorithm[t].second) {
-#ifdef COLLECT_PR_DATA
-        this->num_only_ssr_queries++;
-#endif
+        if constexpr (profiling) {
+            this->counters.num_only_ssr_queries++;
+        }
         PRINT_DEBUG("  Sink is supportive vertex.")
         return this->supportiveVertexToSSRAlgorithm[t].second->query(s);
     }
@@ -337,9 +319,9 @@ SupportiveVerticesSloppySCCsAPRAlgorithm<
     if (sRep) {
         // either s ->* sRep ->* t  => TRUE
         // or sRep ->* s, but sRep -/>* t  => FALSE
-#ifdef COLLECT_PR_DATA
-        num_scc_via_srep_queries++;
-#endif
+        if constexpr (profiling) {
+            sccCounters.num_scc_via_srep_queries++;
+        }
         PRINT_DEBUG("  Answering query via source rep.")
         return this->supportiveVertexToSSRAlgorithm(sRep).first->query(t);
     }
@@ -349,9 +331,9 @@ SupportiveVerticesSloppySCCsAPRAlgorithm<
     if (tRep) {
         // either s ->* tRep ->* t  => TRUE
         // or t ->* tRep, but s -/>* tRep  => FALSE
-#ifdef COLLECT_PR_DATA
-        num_scc_via_trep_queries++;
-#endif
+        if constexpr (profiling) {
+            sccCounters.num_scc_via_trep_queries++;
+        }
         PRINT_DEBUG("  Answering query via target rep.")
         return this->supportiveVertexToSSRAlgorithm(tRep).second->query(s);
     }
@@ -362,36 +344,36 @@ SupportiveVerticesSloppySCCsAPRAlgorithm<
         auto sv = ssink->query(s);
         if (sv) {
             if (vt) {
-#ifdef COLLECT_PR_DATA
-                this->num_only_support_queries_svt++;
-#endif
+                if constexpr (profiling) {
+                    this->counters.num_only_support_queries_svt++;
+                }
                 PRINT_DEBUG("  Reachability established via supportive vertex "
                             << ssrc->getSource() <<  ".")
                 return true;
             }
         } else if (ssink->query(t)) {
             // no path from s to v, but from t to v
-#ifdef COLLECT_PR_DATA
-                this->num_only_support_queries_tv++;
-#endif
+                if constexpr (profiling) {
+                    this->counters.num_only_support_queries_tv++;
+                }
                 PRINT_DEBUG("  Non-reachability established via supportive vertex "
                             << ssrc->getSource() <<  ".")
                 return false;
         }
         if (!vt && ssrc->query(s)) {
             // no path from v to t, but from v to s
-#ifdef COLLECT_PR_DATA
-                this->num_only_support_queries_vs++;
-#endif
+                if constexpr (profiling) {
+                    this->counters.num_only_support_queries_vs++;
+                }
                 PRINT_DEBUG("  Non-reachability established via supportive vertex "
                             << ssrc->getSource() <<  ".")
                 return false;
         }
     }
 
-#ifdef COLLECT_PR_DATA
-                this->num_expensive_queries++;
-#endif
+                if constexpr (profiling) {
+                    this->counters.num_expensive_queries++;
+                }
     PRINT_DEBUG("  Running 2-way BFS...")
     // start two-way BFS
     FindDiPathAlgorithm<FastPropertyMap> fpa;
@@ -403,41 +385,41 @@ SupportiveVerticesSloppySCCsAPRAlgorithm<
     return fpa.deliver();
 }
 
-template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust>
+template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust, bool profiling>
 std::vector<Arc *>
 SupportiveVerticesSloppySCCsAPRAlgorithm<
-                DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust>
+                DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust, profiling>
     ::queryPath(Vertex *s, Vertex *t)
 {
     auto emptyPath = std::vector<Arc*>();
     PRINT_DEBUG("Processing reachability query " << s << " -> " << t << "...")
     if (s == t) {
-#ifdef COLLECT_PR_DATA
-        this->num_trivial_queries++;
-#endif
+        if constexpr (profiling) {
+            this->counters.num_trivial_queries++;
+        }
         PRINT_DEBUG("  Same vertices, trivially true, return empty path.")
         return emptyPath;
     }
     if (this->diGraph->isSink(s) || this->diGraph->isSource(t)) {
-#ifdef COLLECT_PR_DATA
-        this->num_trivial_queries++;
-#endif
+        if constexpr (profiling) {
+            this->counters.num_trivial_queries++;
+        }
         PRINT_DEBUG("  Source is sink or target is source, trivially false, return empty path.")
         return emptyPath;
     }
 
     if (this->supportiveVertexToSSRAlgorithm[s].first) {
-#ifdef COLLECT_PR_DATA
-        this->num_only_ssr_queries++;
-#endif
+        if constexpr (profiling) {
+            this->counters.num_only_ssr_queries++;
+        }
         PRINT_DEBUG("  Source is supportive vertex.")
         return this->supportiveVertexToSSRAlgorithm[s].first->queryPath(t);
     }
 
     if (this->supportiveVertexToSSRAlgorithm[t].second) {
-#ifdef COLLECT_PR_DATA
-        this->num_only_ssr_queries++;
-#endif
+        if constexpr (profiling) {
+            this->counters.num_only_ssr_queries++;
+        }
         PRINT_DEBUG("  Sink is supportive vertex.")
         return this->supportiveVertexToSSRAlgorithm[t].second->queryPath(s);
     }
@@ -474,9 +456,9 @@ SupportiveVerticesSloppySCCsAPRAlgorithm<
     if (sRep) {
         // either s ->* sRep ->* t  => TRUE
         // or sRep ->* s, but sRep -/>* t  => FALSE
-#ifdef COLLECT_PR_DATA
-        num_scc_via_srep_queries++;
-#endif
+        if constexpr (profiling) {
+            sccCounters.num_scc_via_srep_queries++;
+        }
         PRINT_DEBUG("  Answering query via source rep.")
         auto ssrc = this->supportiveVertexToSSRAlgorithm(sRep).first;
         if (ssrc->query(t)) {
@@ -493,9 +475,9 @@ SupportiveVerticesSloppySCCsAPRAlgorithm<
     if (tRep) {
         // either s ->* tRep ->* t  => TRUE
         // or t ->* tRep, but s -/>* tRep  => FALSE
-#ifdef COLLECT_PR_DATA
-        num_scc_via_trep_queries++;
-#endif
+        if constexpr (profiling) {
+            sccCounters.num_scc_via_trep_queries++;
+        }
         PRINT_DEBUG("  Answering query via target rep.")
         auto ssink = this->supportiveVertexToSSRAlgorithm(tRep).second;
         if (ssink->query(s)) {
@@ -513,9 +495,9 @@ SupportiveVerticesSloppySCCsAPRAlgorithm<
         auto sv = ssink->query(s);
         if (sv) {
             if (vt) {
-#ifdef COLLECT_PR_DATA
-                this->num_only_support_queries_svt++;
-#endif
+                if constexpr (profiling) {
+                    this->counters.num_only_support_queries_svt++;
+                }
                 PRINT_DEBUG("  Reachability established via supportive vertex "
                             << ssrc->getSource() <<  ".")
                 auto svPath = ssink->queryPath(s);
@@ -525,27 +507,27 @@ SupportiveVerticesSloppySCCsAPRAlgorithm<
             }
         } else if (ssink->query(t)) {
             // no path from s to v, but from t to v
-#ifdef COLLECT_PR_DATA
-                this->num_only_support_queries_tv++;
-#endif
+                if constexpr (profiling) {
+                    this->counters.num_only_support_queries_tv++;
+                }
                 PRINT_DEBUG("  Non-reachability established via supportive vertex "
                             << ssrc->getSource() <<  ".")
                 return emptyPath;
         }
         if (!vt && ssrc->query(s)) {
             // no path from v to t, but from v to s
-#ifdef COLLECT_PR_DATA
-                this->num_only_support_queries_vs++;
-#endif
+                if constexpr (profiling) {
+                    this->counters.num_only_support_queries_vs++;
+                }
                 PRINT_DEBUG("  Non-reachability established via supportive vertex "
                             << ssrc->getSource() <<  ".")
                 return emptyPath;
         }
     }
 
-#ifdef COLLECT_PR_DATA
-                this->num_expensive_queries++;
-#endif
+                if constexpr (profiling) {
+                    this->counters.num_expensive_queries++;
+                }
     PRINT_DEBUG("  Running 2-way BFS...")
     // start two-way BFS
     FindDiPathAlgorithm<FastPropertyMap> fpa;
@@ -560,22 +542,23 @@ SupportiveVerticesSloppySCCsAPRAlgorithm<
     return emptyPath;
 }
 
-template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust>
+template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust, bool profiling>
 void
 SupportiveVerticesSloppySCCsAPRAlgorithm<
-                DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust>
+                DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust, profiling>
     ::onDiGraphSet()
 {
     Super::onDiGraphSet();
 
-    num_scc_via_srep_queries = 0;
-    num_scc_via_trep_queries = 0;
+    if constexpr (profiling) {
+        sccCounters = SCCCounters();
+    }
 }
 
-template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust>
+template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust, bool profiling>
 void
 SupportiveVerticesSloppySCCsAPRAlgorithm<
-                DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust>
+                DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust, profiling>
     ::checkSCCs()
 {
     PRINT_DEBUG("Checking SCCs...")
@@ -690,10 +673,10 @@ SupportiveVerticesSloppySCCsAPRAlgorithm<
     }
 }
 
-template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust>
+template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm, bool reAdjust, bool profiling>
 void
 SupportiveVerticesSloppySCCsAPRAlgorithm<
-                DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust>
+                DynamicSingleSourceAlgorithm, DynamicSingleSinkAlgorithm, reAdjust, profiling>
     ::createSupportVertex(Vertex *v)
 {
     PRINT_DEBUG("  Creating SV " << v)
@@ -7,19 +7,19 @@
 namespace Algora {
 
 template<typename DynamicSingleSourceAlgorithm, typename DynamicSingleSinkAlgorithm,
-         bool reAdjust = false>
+         bool reAdjust = false, bool profiling = Profiling::Default>
 class SupportiveVerticesSloppySCCsAPRAlgorithm
         : public SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<
                                                             DynamicSingleSourceAlgorithm,
                                                             DynamicSingleSinkAlgorithm,
-                                                            reAdjust>
+                                                            reAdjust, profiling>
 {
 public:
     typedef
         SupportiveVerticesDynamicAllPairsReachabilityAlgorithm<
                                                             DynamicSingleSourceAlgorithm,
                                                             DynamicSingleSinkAlgorithm,
-                                                            reAdjust> Super;
+                                                            reAdjust, profiling> Super;
 
     explicit SupportiveVerticesSloppySCCsAPRAlgorithm(double supportSize, unsigned long adjustAfter);
     explicit SupportiveVerticesSloppySCCsAPRAlgorithm(double supportSize,
@@ -60,8 +60,11 @@ private:
     FastPropertyMap<Vertex*> vertexToSCCRepresentative;
     DiGraph::size_type minSccSize = 5;
 
-    typename Super::profiling_counter num_scc_via_srep_queries = 0;
-    typename Super::profiling_counter num_scc_via_trep_queries = 0;
+    struct SCCCounters {
+        typename Super::profiling_counter num_scc_via_srep_queries = 0;
+        typename Super::profiling_counter num_scc_via_trep_queries = 0;
+    };
+    [[no_unique_address]] Profiling::Storage<profiling, SCCCounters> sccCounters;
 
     void checkSCCs();
     void createSupportVertex(Vertex *v);
@@ -29,6 +29,7 @@
 #include "graph/vertex.h"
 #include "algorithm.basic.traversal/breadthfirstsearch.h"
 #include "algorithm/digraphalgorithmexception.h"
+#include "profiling/tracer.h"
 
 //#define DEBUG_ESTREEML
 
@@ -54,26 +55,19 @@ void printQueue(boost::circular_buffer<ESVertexData*> q) {
 }
 #endif
 
-template<bool reverseArcDirection>
-ESTreeML<reverseArcDirection>::ESTreeML(unsigned int requeueLimit, double maxAffectedRatio)
-    : ESTreeML<reverseArcDirection>(std::make_pair(requeueLimit, maxAffectedRatio))
+template<bool reverseArcDirection, bool profiling>
+ESTreeML<reverseArcDirection, profiling>::ESTreeML(unsigned int requeueLimit, double maxAffectedRatio)
+    : ESTreeML<reverseArcDirection, profiling>(std::make_pair(requeueLimit, maxAffectedRatio))
 {
 }
 
-template<bool reverseArcDirection>
-ESTreeML<reverseArcDirection>::ESTreeML(const ESTreeML<reverseArcDirection>::ParameterSet &params)
+template<bool reverseArcDirection, bool profiling>
+ESTreeML<reverseArcDirection, profiling>::ESTreeML(const ESTreeML<reverseArcDirection, profiling>::ParameterSet &params)
     : DynamicSingleSourceReachabilityAlgorithm(), root(nullptr),
       initialized(false),
       requeueLimit(std::get<0>(params)),
       maxAffectedRatio(std::get<1>(params)),
-      movesDown(0U), movesUp(0U),
-      levelIncrease(0U), levelDecrease(0U),
-      maxLevelIncrease(0U), maxLevelDecrease(0U),
-      decUnreachableHead(0U), decNonTreeArc(0U),
-      incUnreachableTail(0U), incNonTreeArc(0U),
-      reruns(0U), maxReQueued(0U),
-      maxAffected(0U), totalAffected(0U),
-      rerunRequeued(0U), rerunNumAffected(0U)
+      requeued(0U)
 {
     data.setDefaultValue(nullptr);
     inNeighborIndices.setDefaultValue(0U);
@@ -82,14 +76,14 @@ ESTreeML<reverseArcDirection>::ESTreeML(const ESTreeML<reverseArcDirection>::Par
     timesInQueue.setDefaultValue(0U);
 }
 
-template<bool reverseArcDirection>
-ESTreeML<reverseArcDirection>::~ESTreeML()
+template<bool reverseArcDirection, bool profiling>
+ESTreeML<reverseArcDirection, profiling>::~ESTreeML()
 {
     cleanup(true);
 }
 
-template<bool reverseArcDirection>
-void ESTreeML<reverseArcDirection>::run()
+template<bool reverseArcDirection, bool profiling>
+void ESTreeML<reverseArcDirection, profiling>::run()
 {
     if (initialized) {
         return;
@@ -121,10 +115,10 @@ void ESTreeML<reverseArcDirection>::run()
    }
    reachable[root] = true;
    bfs.onTreeArcDiscover([this](Arc *a) {
-#ifdef COLLECT_PR_DATA
-        prVertexConsidered();
-        prArcConsidered();
-#endif
+        if constexpr (profiling) {
+            prVertexConsidered();
+            prArcConsidered();
+        }
         Vertex *t;
         Vertex *h;
         if (reverseArcDirection) {
@@ -148,9 +142,9 @@ void ESTreeML<reverseArcDirection>::run()
                 || (reverseArcDirection && a->getTail() == source)) {
             return;
         }
-#ifdef COLLECT_PR_DATA
-        prArcConsidered();
-#endif
+        if constexpr (profiling) {
+            prArcConsidered();
+        }
         Vertex *t;
         Vertex *h;
         if (reverseArcDirection) {
@@ -168,9 +162,9 @@ void ESTreeML<reverseArcDirection>::run()
    runAlgorithm(bfs, diGraph);
 
    diGraph->mapArcs([this](Arc *a) {
-#ifdef COLLECT_PR_DATA
-        prArcConsidered();
-#endif
+        if constexpr (profiling) {
+            prArcConsidered();
+        }
        if (a->isLoop()
                 || (!reverseArcDirection && a->getHead() == source)
                 || (reverseArcDirection && a->getTail() == source)) {
@@ -203,9 +197,9 @@ void ESTreeML<reverseArcDirection>::run()
    });
 
    diGraph->mapVertices([this](Vertex *v) {
-#ifdef COLLECT_PR_DATA
-        prVertexConsidered();
-#endif
+        if constexpr (profiling) {
+            prVertexConsidered();
+        }
        if (data(v) == nullptr) {
            data[v] = new ESVertexData(&inNeighborIndices, v);
            PRINT_DEBUG( v << " is unreachable.")
@@ -224,90 +218,90 @@ void ESTreeML<reverseArcDirection>::run()
    assert(checkTree());
 }
 
-template<bool reverseArcDirection>
-std::string ESTreeML<reverseArcDirection>::getProfilingInfo() const
+template<bool reverseArcDirection, bool profiling>
+std::string ESTreeML<reverseArcDirection, profiling>::getProfilingInfo() const
 {
     std::stringstream ss;
-#ifdef COLLECT_PR_DATA
-    ss << DynamicSingleSourceReachabilityAlgorithm::getProfilingInfo();
-    ss << "#moves down (level increase): " << movesDown << std::endl;
-    ss << "#moves up (level decrease): " << movesUp << std::endl;
-    ss << "total level increase: " << levelIncrease << std::endl;
-    ss << "total level decrease: " << levelDecrease << std::endl;
-    ss << "maximum level increase: " << maxLevelIncrease << std::endl;
-    ss << "maximum level decrease: " << maxLevelDecrease << std::endl;
-    ss << "#unreachable head (dec): " << decUnreachableHead << std::endl;
-    ss << "#non-tree arcs (dec): " << decNonTreeArc << std::endl;
-    ss << "#unreachable tail (inc): " << incUnreachableTail << std::endl;
-    ss << "#non-tree arcs (inc): " << incNonTreeArc << std::endl;
-    ss << "requeue limit: " << requeueLimit << std::endl;
-    ss << "maximum #requeuings: " << maxReQueued << std::endl;
-    ss << "maximum ratio of affected vertices: " << maxAffectedRatio << std::endl;
-    ss << "total affected vertices: " << totalAffected << std::endl;
-    ss << "maximum number of affected vertices: " << maxAffected << std::endl;
-    ss << "#reruns: " << reruns << std::endl;
-    ss << "#reruns because requeue limit reached: " << rerunRequeued << std::endl;
-    ss << "#reruns because max. number of affected vertices reached: " << rerunNumAffected << std::endl;
-#endif
+    if constexpr (profiling) {
+        ss << DynamicSingleSourceReachabilityAlgorithm::getProfilingInfo();
+        ss << "#moves down (level increase): " << counters.movesDown << std::endl;
+        ss << "#moves up (level decrease): " << counters.movesUp << std::endl;
+        ss << "total level increase: " << counters.levelIncrease << std::endl;
+        ss << "total level decrease: " << counters.levelDecrease << std::endl;
+        ss << "maximum level increase: " << counters.maxLevelIncrease << std::endl;
+        ss << "maximum level decrease: " << counters.maxLevelDecrease << std::endl;
+        ss << "#unreachable head (dec): " << counters.decUnreachableHead << std::endl;
+        ss << "#non-tree arcs (dec): " << counters.decNonTreeArc << std::endl;
+        ss << "#unreachable tail (inc): " << counters.incUnreachableTail << std::endl;
+        ss << "#non-tree arcs (inc): " << counters.incNonTreeArc << std::endl;
+        ss << "requeue limit: " << requeueLimit << std::endl;
+        ss << "maximum #requeuings: " << counters.maxReQueued << std::endl;
+        ss << "maximum ratio of affected vertices: " << maxAffectedRatio << std::endl;
+        ss << "total affected vertices: " << counters.totalAffected << std::endl;
+        ss << "maximum number of affected vertices: " << counters.maxAffected << std::endl;
+        ss << "#reruns: " << counters.reruns << std::endl;
+        ss << "#reruns because requeue limit reached: " << counters.rerunRequeued << std::endl;
+        ss << "#reruns because max. number of affected vertices reached: " << counters.rerunNumAffected << std::endl;
+    }
     return ss.str();
 }
 
-template<bool reverseArcDirection>
-DynamicSingleSourceReachabilityAlgorithm::Profile ESTreeML<reverseArcDirection>::getProfile() const
+template<bool reverseArcDirection, bool profiling>
+DynamicSingleSourceReachabilityAlgorithm::Profile ESTreeML<reverseArcDirection, profiling>::getProfile() const
 {
     auto profile = DynamicSingleSourceReachabilityAlgorithm::getProfile();
-    profile.push_back(std::make_pair(std::string("vertices_moved_down"), movesDown));
-    profile.push_back(std::make_pair(std::string("vertices_moved_up"), movesUp));
-    profile.push_back(std::make_pair(std::string("total_level_increase"), levelIncrease));
-    profile.push_back(std::make_pair(std::string("total_level_decrease"), levelDecrease));
-    profile.push_back(std::make_pair(std::string("max_level_increase"), maxLevelIncrease));
-    profile.push_back(std::make_pair(std::string("max_level_decrease"), maxLevelDecrease));
-    profile.push_back(std::make_pair(std::string("dec_head_unreachable"), decUnreachableHead));
-    profile.push_back(std::make_pair(std::string("dec_nontree"), decNonTreeArc));
-    profile.push_back(std::make_pair(std::string("inc_tail_unreachable"), incUnreachableTail));
-    profile.push_back(std::make_pair(std::string("inc_nontree"), incNonTreeArc));
     profile.push_back(std::make_pair(std::string("requeue_limit"), requeueLimit));
     profile.push_back(std::make_pair(std::string("max_affected"), maxAffectedRatio));
-    profile.push_back(std::make_pair(std::string("max_requeued"), maxReQueued));
-    profile.push_back(std::make_pair(std::string("total_affected"), totalAffected));
-    profile.push_back(std::make_pair(std::string("max_affected"), maxAffected));
-    profile.push_back(std::make_pair(std::string("rerun"), reruns));
-    profile.push_back(std::make_pair(std::string("rerun_requeue_limit"), rerunRequeued));
-    profile.push_back(std::make_pair(std::string("rerun_max_affected"), rerunNumAffected));
+    if constexpr (profiling) {
+        profile.push_back(std::make_pair(std::string("vertices_moved_down"), counters.movesDown));
+        profile.push_back(std::make_pair(std::string("vertices_moved_up"), counters.movesUp));
+        profile.push_back(std::make_pair(std::string("total_level_increase"), counters.levelIncrease));
+        profile.push_back(std::make_pair(std::string("total_level_decrease"), counters.levelDecrease));
+        profile.push_back(std::make_pair(std::string("max_level_increase"), counters.maxLevelIncrease));
+        profile.push_back(std::make_pair(std::string("max_level_decrease"), counters.maxLevelDecrease));
+        profile.push_back(std::make_pair(std::string("dec_head_unreachable"), counters.decUnreachableHead));
+        profile.push_back(std::make_pair(std::string("dec_nontree"), counters.decNonTreeArc));
+        profile.push_back(std::make_pair(std::string("inc_tail_unreachable"), counters.incUnreachableTail));
+        profile.push_back(std::make_pair(std::string("inc_nontree"), counters.incNonTreeArc));
+        profile.push_back(std::make_pair(std::string("max_requeued"), counters.maxReQueued));
+        profile.push_back(std::make_pair(std::string("total_affected"), counters.totalAffected));
+        profile.push_back(std::make_pair(std::string("max_affected"), counters.maxAffected));
+        profile.push_back(std::make_pair(std::string("rerun"), counters.reruns));
+        profile.push_back(std::make_pair(std::string("rerun_requeue_limit"), counters.rerunRequeued));
+        profile.push_back(std::make_pair(std::string("rerun_max_affected"), counters.rerunNumAffected));
+        updateDistributions.addTo(profile);
+    }
     return profile;
 }
 
-template<bool reverseArcDirection>
-void ESTreeML<reverseArcDirection>::onDiGraphSet()
+template<bool reverseArcDirection, bool profiling>
+void ESTreeML<reverseArcDirection, profiling>::onDiGraphSet()
 {
     DynamicSingleSourceReachabilityAlgorithm::onDiGraphSet();
     cleanup(false);
 
-    movesDown = 0U;
-    movesUp = 0U;
-    levelIncrease = 0U;
-    levelDecrease = 0U;
-    decUnreachableHead = 0U;
-    decNonTreeArc = 0U;
-    incUnreachableTail = 0U;
-    incNonTreeArc = 0U;
-    reruns = 0U;
-    maxReQueued = 0U;
-    maxAffected = 0U;
-    totalAffected = 0U;
-    rerunRequeued = 0U;
-    rerunNumAffected = 0U;
+    if constexpr (profiling) {
+        counters = Counters();
+        updateDistributions.clear();
+    }
 }
 
-template<bool reverseArcDirection>
-void ESTreeML<reverseArcDirection>::onDiGraphUnset()
+template<bool reverseArcDirection, bool profiling>
+void ESTreeML<reverseArcDirection, profiling>::onDiGraphUnset()
 {
     DynamicSingleSourceReachabilityAlgorithm::onDiGraphUnset();
     cleanup(true);
 }
 
-template<bool reverseArcDirection>
-void ESTreeML<reverseArcDirection>::onVertexAdd(Vertex *v)
+template<bool reverseArcDirection, bool profiling>
+void ESTreeML<reverseArcDirection, profiling>::onGraphRebuilt(const VertexRemapping &remap)
+{
+    remapSource(remap);
+    cleanup(true);
+}
+
+template<bool reverseArcDirection, bool profiling>
+void ESTreeML<reverseArcDirection, profiling>::onVertexAdd(Vertex *v)
 {
     if (!initialized) {
         return;
@@ -315,8 +309,8 @@ void ESTreeML<reverseArcDirection>::onVertexAdd(Vertex *v)
     data[v] = new ESVertexData(&inNeighborIndices, v);
 }
 
-template<bool reverseArcDirection>
-void ESTreeML<reverseArcDirection>::onArcAdd(Arc *a)
+template<bool reverseArcDirection, bool profiling>
+void ESTreeML<reverseArcDirection, profiling>::onArcAdd(Arc *a)
 {
     if (!initialized) {
         return;
@@ -363,26 +357,32 @@ void ESTreeML<reverseArcDirection>::onArcAdd(Arc *a)
 
     if (!td->isReachable()) {
         PRINT_DEBUG("Tail is unreachable.")
-#ifdef COLLECT_PR_DATA
-        incUnreachableTail++;
-#endif
+        if constexpr (profiling) {
+            counters.incUnreachableTail++;
+            updateDistributions.record(UpdateDistributions::Update::NonTreeArcAdd, {});
+        }
         return;
     }
 
+    [[maybe_unused]] auto before = counters;
+    [[maybe_unused]] auto arcsBefore = pr_consideredArcs;
+
     //update...
     auto diff = hd->reparent(td, a);
     if (diff == 0U) {
         // arc does not change anything
         PRINT_DEBUG("Does not decrease level.")
-#ifdef COLLECT_PR_DATA
-        incNonTreeArc++;
-#endif
+        if constexpr (profiling) {
+            counters.incNonTreeArc++;
+            updateDistributions.record(UpdateDistributions::Update::NonTreeArcAdd, {});
+        }
         return;
     } else {
         PRINT_DEBUG("Is a new tree arc, diff is " << diff);
-#ifdef COLLECT_PR_DATA
-        movesUp++;
-#endif
+        if constexpr (profiling) {
+            counters.movesUp++;
+            counters.levelDecrease += levelDifference(diff);
+        }
         reachable[head] = true;
     }
 
@@ -391,9 +391,9 @@ void ESTreeML<reverseArcDirection>::onArcAdd(Arc *a)
     bfs.onArcDiscover([this](const Arc *ca) {
         auto *a = const_cast<Arc*>(ca);
         PRINT_DEBUG( "Discovering arc " << a << "...");
-#ifdef COLLECT_PR_DATA
-        prArcConsidered();
-#endif
+        if constexpr (profiling) {
+            prArcConsidered();
+        }
         if (a->isLoop()) {
             return false;
         }
@@ -410,27 +410,32 @@ void ESTreeML<reverseArcDirection>::onArcAdd(Arc *a)
         auto ahd = data(ah);
 
         auto diff = ahd->reparent(atd, a);
-#ifdef COLLECT_PR_DATA
-        prVertexConsidered();
-#endif
+        if constexpr (profiling) {
+            prVertexConsidered();
+        }
         if (diff > 0U) {
             PRINT_DEBUG("Is a new tree arc.");
             reachable[ah] = true;
-#ifdef COLLECT_PR_DATA
-            movesUp++;
-            if (diff > maxLevelDecrease) {
-                if (diff - diGraph->getSize() > 0) {
-                    diff -= (ESVertexData::UNREACHABLE - diGraph->getSize());
+            if constexpr (profiling) {
+                counters.movesUp++;
+                auto dec = levelDifference(diff);
+                counters.levelDecrease += dec;
+                if (dec > counters.maxLevelDecrease) {
+                    counters.maxLevelDecrease = dec;
                 }
-                maxLevelDecrease = diff;
             }
-#endif
         }
         return diff > 0U;
 
     });
     runAlgorithm(bfs, diGraph);
 
+    if constexpr (profiling) {
+        updateDistributions.record(UpdateDistributions::Update::TreeArcAdd,
+                                   { counters.movesUp - before.movesUp, pr_consideredArcs - arcsBefore,
+                                     counters.levelDecrease - before.levelDecrease, 0U });
+    }
+
     IF_DEBUG(
     if (!checkTree()) {
         std::cerr << "Tree before:" << std::endl;
@@ -442,8 +447,8 @@ void ESTreeML<reverseArcDirection>::onArcAdd(Arc *a)
    assert(checkTree());
 }
 
-template<bool reverseArcDirection>
-void ESTreeML<reverseArcDirection>::onVertexRemove(Vertex *v)
+template<bool reverseArcDirection, bool profiling>
+void ESTreeML<reverseArcDirection, profiling>::onVertexRemove(Vertex *v)
 {
     if (!initialized) {
         return;
@@ -457,8 +462,8 @@ void ESTreeML<reverseArcDirection>::onVertexRemove(Vertex *v)
      }
 }
 
-template<bool reverseArcDirection>
-void ESTreeML<reverseArcDirection>::onArcRemove(Arc *a)
+template<bool reverseArcDirection, bool profiling>
+void ESTreeML<reverseArcDirection, profiling>::onArcRemove(Arc *a)
 {
    if (!initialized) {
         return;
@@ -519,17 +524,19 @@ void ESTreeML<reverseArcDirection>::onArcRemove(Arc *a)
         } else {
             PRINT_DEBUG("Head of arc is already unreachable. Nothing to do.")
         }
-#ifdef COLLECT_PR_DATA
-        decUnreachableHead++;
-#endif
+        if constexpr (profiling) {
+            counters.decUnreachableHead++;
+            updateDistributions.record(UpdateDistributions::Update::NonTreeArcRemove, {});
+        }
         return;
     }
 
     if (hd->level <= td->level || !isParent) {
         PRINT_DEBUG("Arc is not a tree arc. Nothing to do.");
-#ifdef COLLECT_PR_DATA
-        decNonTreeArc++;
-#endif
+        if constexpr (profiling) {
+            counters.decNonTreeArc++;
+            updateDistributions.record(UpdateDistributions::Update::NonTreeArcRemove, {});
+        }
     } else {
         restoreTree(hd);
     }
@@ -545,14 +552,14 @@ void ESTreeML<reverseArcDirection>::onArcRemove(Arc *a)
    assert(checkTree());
 }
 
-template<bool reverseArcDirection>
-void ESTreeML<reverseArcDirection>::onSourceSet()
+template<bool reverseArcDirection, bool profiling>
+void ESTreeML<reverseArcDirection, profiling>::onSourceSet()
 {
     cleanup(false);
 }
 
-template<bool reverseArcDirection>
-bool ESTreeML<reverseArcDirection>::query(const Vertex *t)
+template<bool reverseArcDirection, bool profiling>
+bool ESTreeML<reverseArcDirection, profiling>::query(const Vertex *t)
 {
     if (t == source) {
         return true;
@@ -565,8 +572,8 @@ bool ESTreeML<reverseArcDirection>::query(const Vertex *t)
     return reachable(t);
 }
 
-template<bool reverseArcDirection>
-std::vector<Arc *> ESTreeML<reverseArcDirection>::queryPath(const Vertex *t)
+template<bool reverseArcDirection, bool profiling>
+std::vector<Arc *> ESTreeML<reverseArcDirection, profiling>::queryPath(const Vertex *t)
 {
     std::vector<Arc*> path;
     if (!query(t) || t == source) {
@@ -587,8 +594,8 @@ std::vector<Arc *> ESTreeML<reverseArcDirection>::queryPath(const Vertex *t)
     return path;
 }
 
-template<bool reverseArcDirection>
-void ESTreeML<reverseArcDirection>::dumpData(std::ostream &os) const
+template<bool reverseArcDirection, bool profiling>
+void ESTreeML<reverseArcDirection, profiling>::dumpData(std::ostream &os) const
 {
     if (!initialized) {
         os << "uninitialized" << std::endl;
@@ -609,8 +616,8 @@ void ESTreeML<reverseArcDirection>::dumpData(std::ostream &os) const
     }
 }
 
-template<bool reverseArcDirection>
-void ESTreeML<reverseArcDirection>::dumpTree(std::ostream &os)
+template<bool reverseArcDirection, bool profiling>
+void ESTreeML<reverseArcDirection, profiling>::dumpTree(std::ostream &os)
 {
     if (!initialized) {
         os << "uninitialized" << std::endl;
@@ -622,8 +629,8 @@ void ESTreeML<reverseArcDirection>::dumpTree(std::ostream &os)
     }
 }
 
-template<bool reverseArcDirection>
-bool ESTreeML<reverseArcDirection>::checkTree()
+template<bool reverseArcDirection, bool profiling>
+bool ESTreeML<reverseArcDirection, profiling>::checkTree()
 {
    BreadthFirstSearch<FastPropertyMap,true,reverseArcDirection> bfs;
    bfs.setStartVertex(source);
@@ -654,12 +661,13 @@ bool ESTreeML<reverseArcDirection>::checkTree()
    return ok;
 }
 
-template<bool reverseArcDirection>
-void ESTreeML<reverseArcDirection>::rerun()
+template<bool reverseArcDirection, bool profiling>
+void ESTreeML<reverseArcDirection, profiling>::rerun()
 {
-#ifdef COLLECT_PR_DATA
-    reruns++;
-#endif
+    PhaseCounter counter(this, Phase::Rerun);
+    if constexpr (profiling) {
+        counters.reruns++;
+    }
     diGraph->mapVertices([&](Vertex *v) {
         data[v]->reset();
     });
@@ -667,8 +675,8 @@ void ESTreeML<reverseArcDirection>::rerun()
     run();
 }
 
-template<bool reverseArcDirection>
-DiGraph::size_type ESTreeML<reverseArcDirection>::process(ESVertexData *vd, bool &limitReached)
+template<bool reverseArcDirection, bool profiling>
+DiGraph::size_type ESTreeML<reverseArcDirection, profiling>::process(ESVertexData *vd, bool &limitReached)
 {
     if (vd->getLevel() == 0ULL) {
         PRINT_DEBUG("No need to process source vertex " << vd << ".");
@@ -682,10 +690,8 @@ DiGraph::size_type ESTreeML<reverseArcDirection>::process(ESVertexData *vd, bool
         return 0U;
     }
 
-#ifdef COLLECT_PR_DATA
-    auto verticesConsidered = 0U;
-    auto arcsConsidered = 0U;
-#endif
+    [[maybe_unused]] auto verticesConsidered = 0U;
+    [[maybe_unused]] auto arcsConsidered = 0U;
 
     Vertex *v = vd->getVertex();
     bool reachV = true;
@@ -699,8 +705,13 @@ DiGraph::size_type ESTreeML<reverseArcDirection>::process(ESVertexData *vd, bool
         if (timesInQueue[vertex] < requeueLimit) {
             PRINT_DEBUG("    Adding " << vd << " to queue...");
             timesInQueue[vertex]++;
-            if (timesInQueue[vertex] > maxReQueued) {
-                maxReQueued = timesInQueue[vertex];
+            if constexpr (profiling) {
+                if (timesInQueue[vertex] > counters.maxReQueued) {
+                    counters.maxReQueued = timesInQueue[vertex];
+                }
+            }
+            if (timesInQueue[vertex] > 1U) {
+                requeued++;
             }
             queue.push_back(vd);
         } else {
@@ -735,9 +746,9 @@ DiGraph::size_type ESTreeML<reverseArcDirection>::process(ESVertexData *vd, bool
 
         while (reachV && (parent == nullptr || vd->level <= parent->level)
                && (!levelChanged || vd->parentIndex < oldIndex)) {
-#ifdef COLLECT_PR_DATA
-            verticesConsidered++;
-#endif
+            if constexpr (profiling) {
+                verticesConsidered++;
+            }
             vd->parentIndex++;
             PRINT_DEBUG("  Advancing parent index to " << vd->parentIndex << ".")
 
@@ -776,17 +787,17 @@ DiGraph::size_type ESTreeML<reverseArcDirection>::process(ESVertexData *vd, bool
     if (levelChanged) {
         PRINT_DEBUG("Level has changed, checking children in BFS tree.")
         auto updateChildren = [this,&enqueue](Arc *a) {
-#ifdef COLLECT_PR_DATA
-            prArcConsidered();
-#endif
+            if constexpr (profiling) {
+                prArcConsidered();
+            }
             if (a->isLoop()) {
               PRINT_DEBUG("  Ignoring loop.");
               return;
             }
             Vertex *head = reverseArcDirection ? a->getTail() : a->getHead();
-#ifdef COLLECT_PR_DATA
-            prVertexConsidered();
-#endif
+            if constexpr (profiling) {
+                prVertexConsidered();
+            }
             auto *hd = data(head);
             if (hd->isTreeArc(a)) {
                 PRINT_DEBUG("  Adding child " << hd << " to queue.");
@@ -820,17 +831,17 @@ DiGraph::size_type ESTreeML<reverseArcDirection>::process(ESVertexData *vd, bool
     PRINT_DEBUG("Returning level diff " << levelDiff  << " for " << vd << ".");
 
     assert(limitReached || vd->checkIntegrity());
-#ifdef COLLECT_PR_DATA
-        prVerticesConsidered(verticesConsidered);
-        prArcsConsidered(arcsConsidered);
-#endif
+        if constexpr (profiling) {
+            prVerticesConsidered(verticesConsidered);
+            prArcsConsidered(arcsConsidered);
+        }
 
     return levelDiff;
 
 }
 
-template<bool reverseArcDirection>
-void ESTreeML<reverseArcDirection>::restoreTree(ESVertexData *rd)
+template<bool reverseArcDirection, bool profiling>
+void ESTreeML<reverseArcDirection, profiling>::restoreTree(ESVertexData *rd)
 {
     auto n = diGraph->getSize();
     DiGraph::size_type affectedLimit = maxAffectedRatio < 1.0
@@ -840,9 +851,15 @@ void ESTreeML<reverseArcDirection>::restoreTree(ESVertexData *rd)
     timesInQueue[rd->getVertex()]++;
     queue.clear();
     queue.push_back(rd);
-    if (maxReQueued == 0U) {
-        maxReQueued = 1U;
+    if constexpr (profiling) {
+        if (counters.maxReQueued == 0U) {
+            counters.maxReQueued = 1U;
+        }
     }
+    requeued = 0U;
+    [[maybe_unused]] auto before = counters;
+    [[maybe_unused]] auto arcsBefore = pr_consideredArcs;
+    Tracer::Scope trace("restoreTree", "algorithm");
     PRINT_DEBUG("Initialized queue with " << rd << ".")
     bool limitReached = false;
     auto processed = 0U;
@@ -851,47 +868,52 @@ void ESTreeML<reverseArcDirection>::restoreTree(ESVertexData *rd)
         IF_DEBUG(printQueue(queue))
         auto vd = queue.front();
         queue.pop_front();
-#ifdef COLLECT_PR_DATA
-        prVertexConsidered();
-        auto levels = 
-#endif
-        process(vd, limitReached);
+        if constexpr (profiling) {
+            prVertexConsidered();
+        }
+        [[maybe_unused]] auto levels = process(vd, limitReached);
         processed++;
 
         if (limitReached || ((processed + queue.size() > affectedLimit) && !queue.empty())) {
-#ifdef COLLECT_PR_DATA
-            if (limitReached) {
-                rerunRequeued++;
-            }
-            if ((processed + queue.size() > affectedLimit) && !queue.empty()) {
-                rerunNumAffected++;
+            if constexpr (profiling) {
+                if (limitReached) {
+                    counters.rerunRequeued++;
+                }
+                if ((processed + queue.size() > affectedLimit) && !queue.empty()) {
+                    counters.rerunNumAffected++;
+                }
             }
-#endif
             queue.clear();
             rerun();
             break;
-#ifdef COLLECT_PR_DATA
-        } else if (levels > 0U) {
-            movesDown++;
-            levelIncrease += levels;
-            PRINT_DEBUG("total level increase " << levelIncrease);
-            if (levels > maxLevelIncrease) {
-                maxLevelIncrease = levels;
-                PRINT_DEBUG("new max level increase " << maxLevelIncrease);
+        }
+        if constexpr (profiling) {
+            if (levels > 0U) {
+                counters.movesDown++;
+                counters.levelIncrease += levels;
+                PRINT_DEBUG("total level increase " << counters.levelIncrease);
+                if (levels > counters.maxLevelIncrease) {
+                    counters.maxLevelIncrease = levels;
+                    PRINT_DEBUG("new max level increase " << counters.maxLevelIncrease);
+                }
             }
-#endif
         }
     }
-#ifdef COLLECT_PR_DATA
-    totalAffected += processed;
-    if (processed > maxAffected) {
-        maxAffected = processed;
+    if constexpr (profiling) {
+        counters.totalAffected += processed;
+        if (processed > counters.maxAffected) {
+            counters.maxAffected = processed;
+        }
+        updateDistributions.record(UpdateDistributions::Update::TreeArcRemove,
+                                   { processed, pr_consideredArcs - arcsBefore,
+                                     counters.levelIncrease - before.levelIncrease, requeued });
     }
-#endif
+    trace.arg("affected", processed);
+    trace.arg("requeues", requeued);
 }
 
-template<bool reverseArcDirection>
-void ESTreeML<reverseArcDirection>::cleanup(bool freeSpace)
+template<bool reverseArcDirection, bool profiling>
+void ESTreeML<reverseArcDirection, profiling>::cleanup(bool freeSpace)
 {
     if (initialized) {
         for (auto i = data.cbegin(); i != data.cend(); i++) {
@@ -903,10 +925,10 @@ void ESTreeML<reverseArcDirection>::cleanup(bool freeSpace)
 
     queue.clear();
     if (freeSpace || !diGraph) {
-        data.resetAll(0);
-        reachable.resetAll(0);
-        inNeighborIndices.resetAll(0);
-        timesInQueue.resetAll(0);
+        releaseMemory(data);
+        releaseMemory(reachable);
+        releaseMemory(inNeighborIndices);
+        releaseMemory(timesInQueue);
         queue.set_capacity(0);
     } else {
         data.resetAll(diGraph->getSize());
@@ -918,6 +940,8 @@ void ESTreeML<reverseArcDirection>::cleanup(bool freeSpace)
     initialized = false ;
 }
 
-template class ESTreeML<false>;
-template class ESTreeML<true>;
+template class ESTreeML<false, Profiling::Off>;
+template class ESTreeML<false, Profiling::On>;
+template class ESTreeML<true, Profiling::Off>;
+template class ESTreeML<true, Profiling::On>;
 }
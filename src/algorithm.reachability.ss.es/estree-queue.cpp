@@ -268,6 +268,12 @@ void ESTreeQ::onDiGraphUnset()
     cleanup(true);
 }
 
+void ESTreeQ::onGraphRebuilt(const VertexRemapping &remap)
+{
+    remapSource(remap);
+    cleanup(true);
+}
+
 void ESTreeQ::onVertexAdd(Vertex *v)
 {
     if (!initialized) {
@@ -768,10 +774,10 @@ void ESTreeQ::cleanup(bool freeSpace)
 
     queue.clear();
     if (freeSpace || !diGraph) {
-        data.resetAll(0);
-        reachable.resetAll(0);
-        inNeighborIndices.resetAll(0);
-        inQueue.resetAll(0);
+        releaseMemory(data);
+        releaseMemory(reachable);
+        releaseMemory(inNeighborIndices);
+        releaseMemory(inQueue);
         queue.set_capacity(0);
     } else {
         data.resetAll(diGraph->getSize());
@@ -75,6 +75,7 @@ public:
 protected:
     virtual void onDiGraphSet() override;
     virtual void onDiGraphUnset() override;
+    virtual void onGraphRebuilt(const VertexRemapping &remap) override;
 
     // DynamicSSReachAlgorithm interface
 protected:
@@ -29,6 +29,7 @@
 #include "graph/vertex.h"
 #include "algorithm.basic.traversal/breadthfirstsearch.h"
 #include "algorithm/digraphalgorithmexception.h"
+#include "profiling/tracer.h"
 
 //#define DEBUG_SIMPLEESTREE
 
@@ -55,24 +56,17 @@ void printQueue(boost::circular_buffer<SESVertexData*> q) {
 #endif
 
 
-template<bool reverseArcDirection>
-SimpleESTree<reverseArcDirection>::SimpleESTree(unsigned int requeueLimit, double maxAffectedRatio)
-    : SimpleESTree<reverseArcDirection>(std::make_pair(requeueLimit, maxAffectedRatio))
+template<bool reverseArcDirection, bool profiling>
+SimpleESTree<reverseArcDirection, profiling>::SimpleESTree(unsigned int requeueLimit, double maxAffectedRatio)
+    : SimpleESTree<reverseArcDirection, profiling>(std::make_pair(requeueLimit, maxAffectedRatio))
 { }
 
-template<bool reverseArcDirection>
-SimpleESTree<reverseArcDirection>::SimpleESTree(const SimpleESTree<reverseArcDirection>::ParameterSet &params)
+template<bool reverseArcDirection, bool profiling>
+SimpleESTree<reverseArcDirection, profiling>::SimpleESTree(const SimpleESTree<reverseArcDirection, profiling>::ParameterSet &params)
     : DynamicSingleSourceReachabilityAlgorithm(), root(nullptr),
       initialized(false), requeueLimit(std::get<0>(params)),
       maxAffectedRatio(std::get<1>(params)),
-      movesDown(0U), movesUp(0U),
-      levelIncrease(0U), levelDecrease(0U),
-      maxLevelIncrease(0U), maxLevelDecrease(0U),
-      decUnreachableHead(0U), decNonTreeArc(0U),
-      incUnreachableTail(0U), incNonTreeArc(0U),
-      reruns(0U), maxReQueued(0U),
-      maxAffected(0U), totalAffected(0U),
-      rerunRequeued(0U), rerunNumAffected(0U)
+      requeued(0U)
 {
     data.setDefaultValue(nullptr);
     reachable.setDefaultValue(false);
@@ -80,14 +74,14 @@ SimpleESTree<reverseArcDirection>::SimpleESTree(const SimpleESTree<reverseArcDir
     timesInQueue.setDefaultValue(0U);
 }
 
-template<bool reverseArcDirection>
-SimpleESTree<reverseArcDirection>::~SimpleESTree()
+template<bool reverseArcDirection, bool profiling>
+SimpleESTree<reverseArcDirection, profiling>::~SimpleESTree()
 {
     cleanup(true);
 }
 
-template<bool reverseArcDirection>
-DiGraph::size_type SimpleESTree<reverseArcDirection>::getDepthOfBFSTree() const
+template<bool reverseArcDirection, bool profiling>
+DiGraph::size_type SimpleESTree<reverseArcDirection, profiling>::getDepthOfBFSTree() const
 {
 	DiGraph::size_type maxLevel = 0U;
     diGraph->mapVertices([&](Vertex *v) {
@@ -98,8 +92,8 @@ DiGraph::size_type SimpleESTree<reverseArcDirection>::getDepthOfBFSTree() const
     return maxLevel;
 }
 
-template<bool reverseArcDirection>
-DiGraph::size_type SimpleESTree<reverseArcDirection>::getNumReachable() const
+template<bool reverseArcDirection, bool profiling>
+DiGraph::size_type SimpleESTree<reverseArcDirection, profiling>::getNumReachable() const
 {
 	DiGraph::size_type numR = 0U;
     diGraph->mapVertices([&](Vertex *v) {
@@ -110,8 +104,8 @@ DiGraph::size_type SimpleESTree<reverseArcDirection>::getNumReachable() const
     return numR;
 }
 
-template<bool reverseArcDirection>
-void SimpleESTree<reverseArcDirection>::run()
+template<bool reverseArcDirection, bool profiling>
+void SimpleESTree<reverseArcDirection, profiling>::run()
 {
     if (initialized) {
         return;
@@ -138,10 +132,10 @@ void SimpleESTree<reverseArcDirection>::run()
    }
    reachable[root] = true;
    bfs.onTreeArcDiscover([this](Arc *a) {
-#ifdef COLLECT_PR_DATA
-        prVertexConsidered();
-        prArcConsidered();
-#endif
+        if constexpr (profiling) {
+            prVertexConsidered();
+            prArcConsidered();
+        }
         Vertex *t;
         Vertex *h;
         if (reverseArcDirection) {
@@ -158,16 +152,16 @@ void SimpleESTree<reverseArcDirection>::run()
         }
         reachable[h] = true;
         PRINT_DEBUG( "(" << a->getTail() << ", " << a->getHead() << ")" << " is a tree arc.")
-#ifdef COLLECT_PR_DATA
-        prArcConsidered();
-#endif
+        if constexpr (profiling) {
+            prArcConsidered();
+        }
    });
    runAlgorithm(bfs, diGraph);
 
    diGraph->mapVertices([this](Vertex *v) {
-#ifdef COLLECT_PR_DATA
-        prVertexConsidered();
-#endif
+        if constexpr (profiling) {
+            prVertexConsidered();
+        }
        if (data(v) == nullptr) {
            data[v] = new SESVertexData(v);
            PRINT_DEBUG( v << " is a unreachable.")
@@ -186,91 +180,91 @@ void SimpleESTree<reverseArcDirection>::run()
    assert(checkTree());
 }
 
-template<bool reverseArcDirection>
-std::string SimpleESTree<reverseArcDirection>::getProfilingInfo() const
+template<bool reverseArcDirection, bool profiling>
+std::string SimpleESTree<reverseArcDirection, profiling>::getProfilingInfo() const
 {
     std::stringstream ss;
-#ifdef COLLECT_PR_DATA
-    ss << DynamicSingleSourceReachabilityAlgorithm::getProfilingInfo();
-    ss << "#moves down (level increase): " << movesDown << std::endl;
-    ss << "#moves up (level decrease): " << movesUp << std::endl;
-    ss << "total level increase: " << levelIncrease << std::endl;
-    ss << "total level decrease: " << levelDecrease << std::endl;
-    ss << "maximum level increase: " << maxLevelIncrease << std::endl;
-    ss << "maximum level decrease: " << maxLevelDecrease << std::endl;
-    ss << "#unreachable head (dec): " << decUnreachableHead << std::endl;
-    ss << "#non-tree arcs (dec): " << decNonTreeArc << std::endl;
-    ss << "#unreachable tail (inc): " << incUnreachableTail << std::endl;
-    ss << "#non-tree arcs (inc): " << incNonTreeArc << std::endl;
-    ss << "requeue limit: " << requeueLimit << std::endl;
-    ss << "maximum #requeuings: " << maxReQueued << std::endl;
-    ss << "maximum ratio of affected vertices: " << maxAffectedRatio << std::endl;
-    ss << "total affected vertices: " << totalAffected << std::endl;
-    ss << "maximum number of affected vertices: " << maxAffected << std::endl;
-    ss << "#reruns: " << reruns << std::endl;
-    ss << "#reruns because requeue limit reached: " << rerunRequeued << std::endl;
-    ss << "#reruns because max. number of affected vertices reached: " << rerunNumAffected << std::endl;
-#endif
+    if constexpr (profiling) {
+        ss << DynamicSingleSourceReachabilityAlgorithm::getProfilingInfo();
+        ss << "#moves down (level increase): " << counters.movesDown << std::endl;
+        ss << "#moves up (level decrease): " << counters.movesUp << std::endl;
+        ss << "total level increase: " << counters.levelIncrease << std::endl;
+        ss << "total level decrease: " << counters.levelDecrease << std::endl;
+        ss << "maximum level increase: " << counters.maxLevelIncrease << std::endl;
+        ss << "maximum level decrease: " << counters.maxLevelDecrease << std::endl;
+        ss << "#unreachable head (dec): " << counters.decUnreachableHead << std::endl;
+        ss << "#non-tree arcs (dec): " << counters.decNonTreeArc << std::endl;
+        ss << "#unreachable tail (inc): " << counters.incUnreachableTail << std::endl;
+        ss << "#non-tree arcs (inc): " << counters.incNonTreeArc << std::endl;
+        ss << "requeue limit: " << requeueLimit << std::endl;
+        ss << "maximum #requeuings: " << counters.maxReQueued << std::endl;
+        ss << "maximum ratio of affected vertices: " << maxAffectedRatio << std::endl;
+        ss << "total affected vertices: " << counters.totalAffected << std::endl;
+        ss << "maximum number of affected vertices: " << counters.maxAffected << std::endl;
+        ss << "#reruns: " << counters.reruns << std::endl;
+        ss << "#reruns because requeue limit reached: " << counters.rerunRequeued << std::endl;
+        ss << "#reruns because max. number of affected vertices reached: " << counters.rerunNumAffected << std::endl;
+    }
     return ss.str();
 }
 
-template<bool reverseArcDirection>
-DynamicSingleSourceReachabilityAlgorithm::Profile SimpleESTree<reverseArcDirection>::getProfile() const
+template<bool reverseArcDirection, bool profiling>
+DynamicSingleSourceReachabilityAlgorithm::Profile SimpleESTree<reverseArcDirection, profiling>::getProfile() const
 {
     auto profile = DynamicSingleSourceReachabilityAlgorithm::getProfile();
-    profile.push_back(std::make_pair(std::string("vertices_moved_down"), movesDown));
-    profile.push_back(std::make_pair(std::string("vertices_moved_up"), movesUp));
-    profile.push_back(std::make_pair(std::string("total_level_increase"), levelIncrease));
-    profile.push_back(std::make_pair(std::string("total_level_decrease"), levelDecrease));
-    profile.push_back(std::make_pair(std::string("max_level_increase"), maxLevelIncrease));
-    profile.push_back(std::make_pair(std::string("max_level_decrease"), maxLevelDecrease));
-    profile.push_back(std::make_pair(std::string("dec_head_unreachable"), decUnreachableHead));
-    profile.push_back(std::make_pair(std::string("dec_nontree"), decNonTreeArc));
-    profile.push_back(std::make_pair(std::string("inc_tail_unreachable"), incUnreachableTail));
-    profile.push_back(std::make_pair(std::string("inc_nontree"), incNonTreeArc));
     profile.push_back(std::make_pair(std::string("requeue_limit"), requeueLimit));
     profile.push_back(std::make_pair(std::string("max_affected"), maxAffectedRatio));
-    profile.push_back(std::make_pair(std::string("max_requeued"), maxReQueued));
-    profile.push_back(std::make_pair(std::string("total_affected"), totalAffected));
-    profile.push_back(std::make_pair(std::string("max_affected"), maxAffected));
-    profile.push_back(std::make_pair(std::string("rerun"), reruns));
-    profile.push_back(std::make_pair(std::string("rerun_requeue_limit"), rerunRequeued));
-    profile.push_back(std::make_pair(std::string("rerun_max_affected"), rerunNumAffected));
+    if constexpr (profiling) {
+        profile.push_back(std::make_pair(std::string("vertices_moved_down"), counters.movesDown));
+        profile.push_back(std::make_pair(std::string("vertices_moved_up"), counters.movesUp));
+        profile.push_back(std::make_pair(std::string("total_level_increase"), counters.levelIncrease));
+        profile.push_back(std::make_pair(std::string("total_level_decrease"), counters.levelDecrease));
+        profile.push_back(std::make_pair(std::string("max_level_increase"), counters.maxLevelIncrease));
+        profile.push_back(std::make_pair(std::string("max_level_decrease"), counters.maxLevelDecrease));
+        profile.push_back(std::make_pair(std::string("dec_head_unreachable"), counters.decUnreachableHead));
+        profile.push_back(std::make_pair(std::string("dec_nontree"), counters.decNonTreeArc));
+        profile.push_back(std::make_pair(std::string("inc_tail_unreachable"), counters.incUnreachableTail));
+        profile.push_back(std::make_pair(std::string("inc_nontree"), counters.incNonTreeArc));
+        profile.push_back(std::make_pair(std::string("max_requeued"), counters.maxReQueued));
+        profile.push_back(std::make_pair(std::string("total_affected"), counters.totalAffected));
+        profile.push_back(std::make_pair(std::string("max_affected"), counters.maxAffected));
+        profile.push_back(std::make_pair(std::string("rerun"), counters.reruns));
+        profile.push_back(std::make_pair(std::string("rerun_requeue_limit"), counters.rerunRequeued));
+        profile.push_back(std::make_pair(std::string("rerun_max_affected"), counters.rerunNumAffected));
+        updateDistributions.addTo(profile);
+    }
     return profile;
 }
 
-template<bool reverseArcDirection>
-void SimpleESTree<reverseArcDirection>::onDiGraphSet()
+template<bool reverseArcDirection, bool profiling>
+void SimpleESTree<reverseArcDirection, profiling>::onDiGraphSet()
 {
     DynamicSingleSourceReachabilityAlgorithm::onDiGraphSet();
     cleanup(false);
 
-    movesDown = 0U;
-    movesUp = 0U;
-    levelIncrease = 0U;
-    levelDecrease = 0U;
-    decUnreachableHead = 0U;
-    decNonTreeArc = 0U;
-    incUnreachableTail = 0U;
-    incNonTreeArc = 0U;
-    reruns = 0U;
-    maxReQueued = 0U;
-    maxAffected = 0U;
-    totalAffected = 0U;
-    rerunRequeued = 0U;
-    rerunNumAffected = 0U;
+    if constexpr (profiling) {
+        counters = Counters();
+        updateDistributions.clear();
+    }
     // called by cleanup
 }
 
-template<bool reverseArcDirection>
-void SimpleESTree<reverseArcDirection>::onDiGraphUnset()
+template<bool reverseArcDirection, bool profiling>
+void SimpleESTree<reverseArcDirection, profiling>::onDiGraphUnset()
 {
     DynamicSingleSourceReachabilityAlgorithm::onDiGraphUnset();
     cleanup(true);
 }
 
-template<bool reverseArcDirection>
-void SimpleESTree<reverseArcDirection>::onVertexAdd(Vertex *v)
+template<bool reverseArcDirection, bool profiling>
+void SimpleESTree<reverseArcDirection, profiling>::onGraphRebuilt(const VertexRemapping &remap)
+{
+    remapSource(remap);
+    cleanup(true);
+}
+
+template<bool reverseArcDirection, bool profiling>
+void SimpleESTree<reverseArcDirection, profiling>::onVertexAdd(Vertex *v)
 {
     if (!initialized) {
         return;
@@ -281,8 +275,8 @@ void SimpleESTree<reverseArcDirection>::onVertexAdd(Vertex *v)
     data[v] = new SESVertexData(v);
 }
 
-template<bool reverseArcDirection>
-void SimpleESTree<reverseArcDirection>::onArcAdd(Arc *a)
+template<bool reverseArcDirection, bool profiling>
+void SimpleESTree<reverseArcDirection, profiling>::onArcAdd(Arc *a)
 {
     if (!initialized) {
         return;
@@ -318,49 +312,47 @@ void SimpleESTree<reverseArcDirection>::onArcAdd(Arc *a)
 
     if (!td->isReachable()) {
         PRINT_DEBUG("Tail is unreachable.")
-#ifdef COLLECT_PR_DATA
-        incUnreachableTail++;
-#endif
+        if constexpr (profiling) {
+            counters.incUnreachableTail++;
+            updateDistributions.record(UpdateDistributions::Update::NonTreeArcAdd, {});
+        }
         return;
     }
 
-#ifdef COLLECT_PR_DATA
-    auto n = diGraph->getSize();
-#endif
+    [[maybe_unused]] auto n = diGraph->getSize();
+    [[maybe_unused]] auto before = counters;
+    [[maybe_unused]] auto arcsBefore = pr_consideredArcs;
 
     //update...
     if (hd->level <= td->level + 1) {
         // arc does not change anything
-#ifdef COLLECT_PR_DATA
-        incNonTreeArc++;
-#endif
+        if constexpr (profiling) {
+            counters.incNonTreeArc++;
+            updateDistributions.record(UpdateDistributions::Update::NonTreeArcAdd, {});
+        }
         PRINT_DEBUG("Not a tree arc.")
         return;
     } else {
         PRINT_DEBUG("Is a new tree arc.")
-#ifdef COLLECT_PR_DATA
-        movesUp++;
-        if (!hd->isReachable()) {
-            levelDecrease += (n -  (td->level + 1));
-        } else {
-            levelDecrease += (hd->level - (td->level + 1));
+        if constexpr (profiling) {
+            counters.movesUp++;
+            if (!hd->isReachable()) {
+                counters.levelDecrease += (n -  (td->level + 1));
+            } else {
+                counters.levelDecrease += (hd->level - (td->level + 1));
+            }
         }
-#endif
         hd->setParent(td, a);
         reachable[head] = true;
     }
 
     BreadthFirstSearch<FastPropertyMap,false,reverseArcDirection> bfs(false);
     bfs.setStartVertex(head);
-#ifdef COLLECT_PR_DATA
     bfs.onArcDiscover([this,n](const Arc *a) {
-#else
-    bfs.onArcDiscover([this](const Arc *a) {
-#endif
         PRINT_DEBUG( "Discovering arc (" << a->getTail() << ", " << a->getHead() << ")...");
-#ifdef COLLECT_PR_DATA
-        prArcConsidered();
-#endif
+        if constexpr (profiling) {
+            prArcConsidered();
+        }
         if (a->isLoop()) {
             PRINT_DEBUG( "Loop ignored.");
             return false;
@@ -377,22 +369,22 @@ void SimpleESTree<reverseArcDirection>::onArcAdd(Arc *a)
         auto atd = data(at);
         auto ahd = data(ah);
 
-#ifdef COLLECT_PR_DATA
-        prVertexConsidered();
-#endif
+        if constexpr (profiling) {
+            prVertexConsidered();
+        }
         if (!ahd->isReachable() ||  atd->level + 1 < ahd->level) {
-#ifdef COLLECT_PR_DATA
-            movesUp++;
-            auto newLevel = atd->level + 1;
-            auto dec = n - newLevel;
-            if (ahd->isReachable()) {
-                dec = ahd->level - newLevel;
-            }
-            levelDecrease += dec;
-            if (dec > maxLevelDecrease) {
-                maxLevelDecrease = dec;
+            if constexpr (profiling) {
+                counters.movesUp++;
+                auto newLevel = atd->level + 1;
+                auto dec = n - newLevel;
+                if (ahd->isReachable()) {
+                    dec = ahd->level - newLevel;
+                }
+                counters.levelDecrease += dec;
+                if (dec > counters.maxLevelDecrease) {
+                    counters.maxLevelDecrease = dec;
+                }
             }
-#endif
             ahd->setParent(atd, const_cast<Arc*>(a));
             reachable[ah] = true;
             PRINT_DEBUG( "(" << a->getTail() << ", " << a->getHead() << ")" << " is a new tree arc.");
@@ -404,6 +396,12 @@ void SimpleESTree<reverseArcDirection>::onArcAdd(Arc *a)
     });
     runAlgorithm(bfs, diGraph);
 
+    if constexpr (profiling) {
+        updateDistributions.record(UpdateDistributions::Update::TreeArcAdd,
+                                   { counters.movesUp - before.movesUp, pr_consideredArcs - arcsBefore,
+                                     counters.levelDecrease - before.levelDecrease, 0U });
+    }
+
    IF_DEBUG(
     if (!checkTree()) {
         std::cerr.flush();
@@ -413,8 +411,8 @@ void SimpleESTree<reverseArcDirection>::onArcAdd(Arc *a)
    assert(checkTree());
 }
 
-template<bool reverseArcDirection>
-void SimpleESTree<reverseArcDirection>::onVertexRemove(Vertex *v)
+template<bool reverseArcDirection, bool profiling>
+void SimpleESTree<reverseArcDirection, profiling>::onVertexRemove(Vertex *v)
 {
     if (!initialized) {
         return;
@@ -428,8 +426,8 @@ void SimpleESTree<reverseArcDirection>::onVertexRemove(Vertex *v)
      }
 }
 
-template<bool reverseArcDirection>
-void SimpleESTree<reverseArcDirection>::onArcRemove(Arc *a)
+template<bool reverseArcDirection, bool profiling>
+void SimpleESTree<reverseArcDirection, profiling>::onArcRemove(Arc *a)
 {
    if (!initialized) {
         return;
@@ -469,9 +467,10 @@ void SimpleESTree<reverseArcDirection>::onArcRemove(Arc *a)
         } else {
             PRINT_DEBUG("Head of arc is already unreachable. Nothing to do.")
         }
-#ifdef COLLECT_PR_DATA
-        decUnreachableHead++;
-#endif
+        if constexpr (profiling) {
+            counters.decUnreachableHead++;
+            updateDistributions.record(UpdateDistributions::Update::NonTreeArcRemove, {});
+        }
         return;
     }
 
@@ -481,9 +480,10 @@ void SimpleESTree<reverseArcDirection>::onArcRemove(Arc *a)
         restoreTree(hd);
     } else {
         PRINT_DEBUG("Arc is not a tree arc. Nothing to do.")
-#ifdef COLLECT_PR_DATA
-        decNonTreeArc++;
-#endif
+        if constexpr (profiling) {
+            counters.decNonTreeArc++;
+            updateDistributions.record(UpdateDistributions::Update::NonTreeArcRemove, {});
+        }
     }
 
    IF_DEBUG(
@@ -495,14 +495,14 @@ void SimpleESTree<reverseArcDirection>::onArcRemove(Arc *a)
    assert(checkTree());
 }
 
-template<bool reverseArcDirection>
-void SimpleESTree<reverseArcDirection>::onSourceSet()
+template<bool reverseArcDirection, bool profiling>
+void SimpleESTree<reverseArcDirection, profiling>::onSourceSet()
 {
     cleanup(false);
 }
 
-template<bool reverseArcDirection>
-bool SimpleESTree<reverseArcDirection>::query(const Vertex *t)
+template<bool reverseArcDirection, bool profiling>
+bool SimpleESTree<reverseArcDirection, profiling>::query(const Vertex *t)
 {
     PRINT_DEBUG("Querying reachability of " << t);
     if (t == source) {
@@ -518,8 +518,8 @@ bool SimpleESTree<reverseArcDirection>::query(const Vertex *t)
     return reachable(t);
 }
 
-template<bool reverseArcDirection>
-std::vector<Arc *> SimpleESTree<reverseArcDirection>::queryPath(const Vertex *t)
+template<bool reverseArcDirection, bool profiling>
+std::vector<Arc *> SimpleESTree<reverseArcDirection, profiling>::queryPath(const Vertex *t)
 {
     std::vector<Arc*> path;
     if (!query(t) || t == source) {
@@ -540,8 +540,8 @@ std::vector<Arc *> SimpleESTree<reverseArcDirection>::queryPath(const Vertex *t)
     return path;
 }
 
-template<bool reverseArcDirection>
-void SimpleESTree<reverseArcDirection>::dumpData(std::ostream &os) const
+template<bool reverseArcDirection, bool profiling>
+void SimpleESTree<reverseArcDirection, profiling>::dumpData(std::ostream &os) const
 {
     if (!initialized) {
         os << "uninitialized" << std::endl;
@@ -562,8 +562,8 @@ void SimpleESTree<reverseArcDirection>::dumpData(std::ostream &os) const
     }
 }
 
-template<bool reverseArcDirection>
-void SimpleESTree<reverseArcDirection>::dumpTree(std::ostream &os)
+template<bool reverseArcDirection, bool profiling>
+void SimpleESTree<reverseArcDirection, profiling>::dumpTree(std::ostream &os)
 {
     if (!initialized) {
         os << "uninitialized" << std::endl;
@@ -576,8 +576,8 @@ void SimpleESTree<reverseArcDirection>::dumpTree(std::ostream &os)
     }
 }
 
-template<bool reverseArcDirection>
-bool SimpleESTree<reverseArcDirection>::checkTree()
+template<bool reverseArcDirection, bool profiling>
+bool SimpleESTree<reverseArcDirection, profiling>::checkTree()
 {
    BreadthFirstSearch<FastPropertyMap,true,reverseArcDirection> bfs;
    bfs.setStartVertex(source);
@@ -599,12 +599,13 @@ bool SimpleESTree<reverseArcDirection>::checkTree()
    return ok;
 }
 
-template<bool reverseArcDirection>
-void SimpleESTree<reverseArcDirection>::rerun()
+template<bool reverseArcDirection, bool profiling>
+void SimpleESTree<reverseArcDirection, profiling>::rerun()
 {
-#ifdef COLLECT_PR_DATA
-    reruns++;
-#endif
+    PhaseCounter counter(this, Phase::Rerun);
+    if constexpr (profiling) {
+        counters.reruns++;
+    }
     diGraph->mapVertices([&](Vertex *v) {
         data[v]->reset();
     });
@@ -612,18 +613,16 @@ void SimpleESTree<reverseArcDirection>::rerun()
     run();
 }
 
-template<bool reverseArcDirection>
-DiGraph::size_type SimpleESTree<reverseArcDirection>::process(SESVertexData *vd, bool &limitReached) {
+template<bool reverseArcDirection, bool profiling>
+DiGraph::size_type SimpleESTree<reverseArcDirection, profiling>::process(SESVertexData *vd, bool &limitReached) {
 
     if (vd->level == 0UL) {
         PRINT_DEBUG("No need to process source vertex " << vd << ".");
         return 0U;
     }
 
-#ifdef COLLECT_PR_DATA
-    auto verticesConsidered = 0U;
-    auto arcsConsidered = 0U;
-#endif
+    [[maybe_unused]] auto verticesConsidered = 0U;
+    [[maybe_unused]] auto arcsConsidered = 0U;
 
     PRINT_DEBUG("Processing vertex " << vd << ".");
     Vertex *v = vd->getVertex();
@@ -646,17 +645,17 @@ DiGraph::size_type SimpleESTree<reverseArcDirection>::process(SESVertexData *vd,
     PRINT_DEBUG("Min parent level is " << minParentLevel << ".");
 
     auto findParent = [this,&parent,&minParentLevel,&oldVLevel,&treeArc](Arc *a) {
-#ifdef COLLECT_PR_DATA
-            prArcConsidered();
-#endif
+            if constexpr (profiling) {
+                prArcConsidered();
+            }
         if (a->isLoop()) {
             PRINT_DEBUG( "Loop ignored.");
             return;
         }
         auto pd = data(reverseArcDirection ? a->getHead() : a->getTail());
-#ifdef COLLECT_PR_DATA
-            prVertexConsidered();
-#endif
+            if constexpr (profiling) {
+                prVertexConsidered();
+            }
         auto pLevel = pd->level;
         if (pLevel < minParentLevel) {
             minParentLevel = pLevel;
@@ -699,23 +698,28 @@ DiGraph::size_type SimpleESTree<reverseArcDirection>::process(SESVertexData *vd,
     if (levelDiff > 0U) {
         PRINT_DEBUG("Updating children...");
         auto updateChildren = [this,&limitReached](Arc *a) {
-#ifdef COLLECT_PR_DATA
-            prArcConsidered();
-#endif
+            if constexpr (profiling) {
+                prArcConsidered();
+            }
             if (a->isLoop()) {
                 return;
             }
             Vertex *head = reverseArcDirection ? a->getTail() : a->getHead();
             auto *hd = data(head);
-#ifdef COLLECT_PR_DATA
-            prVertexConsidered();
-#endif
+            if constexpr (profiling) {
+                prVertexConsidered();
+            }
             if (hd->isTreeArc(a)) {
                 if (timesInQueue[head] < requeueLimit) {
                     PRINT_DEBUG("    Adding child " << hd << " to queue...");
                     timesInQueue[head]++;
-                    if (timesInQueue[head] > maxReQueued) {
-                        maxReQueued = timesInQueue[head];
+                    if constexpr (profiling) {
+                        if (timesInQueue[head] > counters.maxReQueued) {
+                            counters.maxReQueued = timesInQueue[head];
+                        }
+                    }
+                    if (timesInQueue[head] > 1U) {
+                        requeued++;
                     }
                     queue.push_back(hd);
                 } else {
@@ -733,16 +737,16 @@ DiGraph::size_type SimpleESTree<reverseArcDirection>::process(SESVertexData *vd,
         }
     }
 
-#ifdef COLLECT_PR_DATA
-        prVerticesConsidered(verticesConsidered);
-        prArcsConsidered(arcsConsidered);
-#endif
+        if constexpr (profiling) {
+            prVerticesConsidered(verticesConsidered);
+            prArcsConsidered(arcsConsidered);
+        }
 
     return levelDiff;
 }
 
-template<bool reverseArcDirection>
-void SimpleESTree<reverseArcDirection>::restoreTree(SESVertexData *rd)
+template<bool reverseArcDirection, bool profiling>
+void SimpleESTree<reverseArcDirection, profiling>::restoreTree(SESVertexData *rd)
 {
     auto n = diGraph->getSize();
     DiGraph::size_type affectedLimit = maxAffectedRatio < 1.0
@@ -752,9 +756,15 @@ void SimpleESTree<reverseArcDirection>::restoreTree(SESVertexData *rd)
     timesInQueue[rd->getVertex()]++;
     queue.clear();
     queue.push_back(rd);
-    if (maxReQueued == 0U) {
-        maxReQueued = 1U;
+    if constexpr (profiling) {
+        if (counters.maxReQueued == 0U) {
+            counters.maxReQueued = 1U;
+        }
     }
+    requeued = 0U;
+    [[maybe_unused]] auto before = counters;
+    [[maybe_unused]] auto arcsBefore = pr_consideredArcs;
+    Tracer::Scope trace("restoreTree", "algorithm");
     PRINT_DEBUG("Initialized queue with " << rd << ".")
     bool limitReached = false;
     auto processed = 0ULL;
@@ -763,45 +773,50 @@ void SimpleESTree<reverseArcDirection>::restoreTree(SESVertexData *rd)
         IF_DEBUG(printQueue(queue))
         auto vd = queue.front();
         queue.pop_front();
-#ifdef COLLECT_PR_DATA
-        prVertexConsidered();
-        auto levels =
-        #endif
-                process(vd, limitReached);
+        if constexpr (profiling) {
+            prVertexConsidered();
+        }
+        [[maybe_unused]] auto levels = process(vd, limitReached);
         processed++;
 
         if (limitReached || ((processed + queue.size() > affectedLimit) && !queue.empty())) {
-#ifdef COLLECT_PR_DATA
-            if (limitReached) {
-                rerunRequeued++;
-            }
-            if ((processed + queue.size() > affectedLimit) && !queue.empty()) {
-                rerunNumAffected++;
+            if constexpr (profiling) {
+                if (limitReached) {
+                    counters.rerunRequeued++;
+                }
+                if ((processed + queue.size() > affectedLimit) && !queue.empty()) {
+                    counters.rerunNumAffected++;
+                }
             }
-#endif
             queue.clear();
             rerun();
             break;
-#ifdef COLLECT_PR_DATA
-        } else if (levels > 0U) {
-            movesDown++;
-            levelIncrease += levels;
-            if (levels > maxLevelIncrease) {
-                maxLevelIncrease = levels;
+        }
+        if constexpr (profiling) {
+            if (levels > 0U) {
+                counters.movesDown++;
+                counters.levelIncrease += levels;
+                if (levels > counters.maxLevelIncrease) {
+                    counters.maxLevelIncrease = levels;
+                }
             }
-#endif
         }
     }
-#ifdef COLLECT_PR_DATA
-    totalAffected += processed;
-    if (processed > maxAffected) {
-        maxAffected = processed;
+    if constexpr (profiling) {
+        counters.totalAffected += processed;
+        if (processed > counters.maxAffected) {
+            counters.maxAffected = processed;
+        }
+        updateDistributions.record(UpdateDistributions::Update::TreeArcRemove,
+                                   { processed, pr_consideredArcs - arcsBefore,
+                                     counters.levelIncrease - before.levelIncrease, requeued });
     }
-#endif
+    trace.arg("affected", processed);
+    trace.arg("requeues", requeued);
 }
 
-template<bool reverseArcDirection>
-void SimpleESTree<reverseArcDirection>::cleanup(bool freeSpace)
+template<bool reverseArcDirection, bool profiling>
+void SimpleESTree<reverseArcDirection, profiling>::cleanup(bool freeSpace)
 {
     if (initialized) {
         for (auto i = data.cbegin(); i != data.cend(); i++) {
@@ -814,9 +829,9 @@ void SimpleESTree<reverseArcDirection>::cleanup(bool freeSpace)
     queue.clear();
 
     if (freeSpace || !diGraph) {
-        data.resetAll(0);
-        reachable.resetAll(0);
-        timesInQueue.resetAll(0);
+        releaseMemory(data);
+        releaseMemory(reachable);
+        releaseMemory(timesInQueue);
         queue.set_capacity(0);
     } else {
         data.resetAll(diGraph->getSize());
@@ -827,6 +842,8 @@ void SimpleESTree<reverseArcDirection>::cleanup(bool freeSpace)
     initialized = false;
 }
 
-template class SimpleESTree<false>;
-template class SimpleESTree<true>;
+template class SimpleESTree<false, Profiling::Off>;
+template class SimpleESTree<false, Profiling::On>;
+template class SimpleESTree<true, Profiling::Off>;
+template class SimpleESTree<true, Profiling::On>;
 }
@@ -26,13 +26,16 @@
 #include "algorithm.reachability.ss/dynamicsinglesourcereachabilityalgorithm.h"
 #include "property/propertymap.h"
 #include "property/fastpropertymap.h"
+#include "profiling/profiling.h"
+#include "profiling/updatedistributions.h"
 #include "sesvertexdata.h"
 #include <sstream>
 #include <boost/circular_buffer.hpp>
 
 namespace Algora {
 
-template<bool reverseArcDirection = false>
+// profiling: collect detailed counters, see Profiling
+template<bool reverseArcDirection = false, bool profiling = Profiling::Default>
 class SimpleESTree : public DynamicSingleSourceReachabilityAlgorithm
 {
 public:
@@ -87,6 +90,7 @@ public:
 protected:
     virtual void onDiGraphSet() override;
     virtual void onDiGraphUnset() override;
+    virtual void onGraphRebuilt(const VertexRemapping &remap) override;
 
     // DynamicSSReachAlgorithm interface
 protected:
@@ -111,22 +115,28 @@ private:
     unsigned int requeueLimit;
     double maxAffectedRatio;
 
-    profiling_counter movesDown;
-    profiling_counter movesUp;
-    profiling_counter levelIncrease;
-    profiling_counter levelDecrease;
-    DiGraph::size_type maxLevelIncrease;
-    DiGraph::size_type maxLevelDecrease;
-    profiling_counter decUnreachableHead;
-    profiling_counter decNonTreeArc;
-    profiling_counter incUnreachableTail;
-    profiling_counter incNonTreeArc;
-    profiling_counter reruns;
-    unsigned int maxReQueued;
-    DiGraph::size_type maxAffected;
-    profiling_counter totalAffected;
-    profiling_counter rerunRequeued;
-    profiling_counter rerunNumAffected;
+    struct Counters {
+        profiling_counter movesDown = 0U;
+        profiling_counter movesUp = 0U;
+        profiling_counter levelIncrease = 0U;
+        profiling_counter levelDecrease = 0U;
+        DiGraph::size_type maxLevelIncrease = 0U;
+        DiGraph::size_type maxLevelDecrease = 0U;
+        profiling_counter decUnreachableHead = 0U;
+        profiling_counter decNonTreeArc = 0U;
+        profiling_counter incUnreachableTail = 0U;
+        profiling_counter incNonTreeArc = 0U;
+        profiling_counter reruns = 0U;
+        unsigned int maxReQueued = 0U;
+        DiGraph::size_type maxAffected = 0U;
+        profiling_counter totalAffected = 0U;
+        profiling_counter rerunRequeued = 0U;
+        profiling_counter rerunNumAffected = 0U;
+    };
+    [[no_unique_address]] Profiling::Storage<profiling, Counters> counters;
+    [[no_unique_address]] Profiling::Storage<profiling, UpdateDistributions> updateDistributions;
+    // vertices queued again during the current restoreTree()
+    DiGraph::size_type requeued;
 
     void restoreTree(SESVertexData *rd);
     void cleanup(bool freeSpace);
@@ -137,8 +147,10 @@ private:
 };
 
 // explicit instantiation declaration
-extern template class SimpleESTree<false>;
-extern template class SimpleESTree<true>;
+extern template class SimpleESTree<false, Profiling::Off>;
+extern template class SimpleESTree<false, Profiling::On>;
+extern template class SimpleESTree<true, Profiling::Off>;
+extern template class SimpleESTree<true, Profiling::On>;
 }
 
 #endif // SIMPLEESTREE_H
@@ -45,6 +45,7 @@ struct CachingBFSSSReachAlgorithm::CheshireCat {
     }
 
     void run() {
+        PhaseCounter counter(parent, Phase::Rerun);
         treeArc.resetAll();
         bfs.setStartVertex(source);
         bfs.onTreeArcDiscover([this](const Arc *a) {
@@ -46,6 +46,7 @@ struct CachingDFSSSReachAlgorithm::CheshireCat {
     }
 
     void run() {
+        PhaseCounter counter(parent, Phase::Rerun);
         treeArc.resetAll();
         dfs.setStartVertex(source);
         dfs.onTreeArcDiscover([this](const Arc *a) {
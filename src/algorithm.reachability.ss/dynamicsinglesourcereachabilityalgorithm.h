@@ -42,6 +42,13 @@ public:
 
     virtual bool query(const Vertex *t) = 0;
     virtual std::vector<Arc*> queryPath(const Vertex *);
+    // query() and queryPath() with their latencies recorded, see recordLatencies()
+    bool timedQuery(const Vertex *t) {
+        return timed(Latency::Query, [this, t]() { return query(t); });
+    }
+    std::vector<Arc*> timedQueryPath(const Vertex *t) {
+        return timed(Latency::QueryPath, [this, t]() { return queryPath(t); });
+    }
 
     // DiGraphAlgorithm interface
 public:
@@ -49,6 +56,15 @@ public:
 
 protected:
     virtual void onSourceSet() { }
+    virtual void onGraphRebuilt(const VertexRemapping &remap) override {
+        remapSource(remap);
+        DynamicDiGraphAlgorithm::onGraphRebuilt(remap);
+    }
+    void remapSource(const VertexRemapping &remap) {
+        if (source) {
+            source = remap(source);
+        }
+    }
 
     Vertex *source;
 };
@@ -26,6 +26,7 @@
 #include "algorithm/digraphalgorithmexception.h"
 #include "property/fastpropertymap.h"
 #include "graph/vertex.h"
+#include "profiling/updatedistributions.h"
 
 #include <vector>
 #include <climits>
@@ -48,11 +49,11 @@
 
 namespace Algora {
 
-template<bool reverseArcDirection>
-struct SimpleIncSSReachAlgorithm<reverseArcDirection>::Reachability {
+template<bool reverseArcDirection, bool profiling>
+struct SimpleIncSSReachAlgorithm<reverseArcDirection, profiling>::Reachability {
     enum struct State : std::int8_t { REACHABLE, UNREACHABLE, UNKNOWN };
 
-    SimpleIncSSReachAlgorithm<reverseArcDirection> *parent;
+    SimpleIncSSReachAlgorithm<reverseArcDirection, profiling> *parent;
     FastPropertyMap<State> reachability;
     FastPropertyMap<Arc*> pred;
     DiGraph *diGraph;
@@ -68,32 +69,33 @@ struct SimpleIncSSReachAlgorithm<reverseArcDirection>::Reachability {
     bool radicalReset;
 
     DiGraph::size_type numReachable;
-    profiling_counter numUnreached;
-    profiling_counter numRereached;
-    profiling_counter numUnknown;
-    profiling_counter numReached;
-    profiling_counter numTracebacks;
-    DiGraph::size_type maxUnreached;
-    DiGraph::size_type maxRereached;
-    DiGraph::size_type maxUnknown;
-    DiGraph::size_type maxReached;
-    profiling_counter maxTracebacks;
-    profiling_counter numReReachFromSource;
-    profiling_counter incNonTreeArc;
-    profiling_counter incUnReachableTail;
-    profiling_counter decNonTreeArc;
-    profiling_counter decUnReachableHead;
-
-    Reachability(SimpleIncSSReachAlgorithm<reverseArcDirection> *p, bool r, bool sf, double maxUS)
+    struct Counters {
+        profiling_counter numUnreached = 0U;
+        profiling_counter numRereached = 0U;
+        profiling_counter numUnknown = 0U;
+        profiling_counter numReached = 0U;
+        profiling_counter numTracebacks = 0U;
+        DiGraph::size_type maxUnreached = 0U;
+        DiGraph::size_type maxRereached = 0U;
+        DiGraph::size_type maxUnknown = 0U;
+        DiGraph::size_type maxReached = 0U;
+        profiling_counter maxTracebacks = 0U;
+        profiling_counter numReReachFromSource = 0U;
+        profiling_counter incNonTreeArc = 0U;
+        profiling_counter incUnReachableTail = 0U;
+        profiling_counter decNonTreeArc = 0U;
+        profiling_counter decUnReachableHead = 0U;
+    };
+    [[no_unique_address]] Profiling::Storage<profiling, Counters> counters;
+    [[no_unique_address]] Profiling::Storage<profiling, UpdateDistributions> updateDistributions;
+    // vertices propagated to during the current update
+    DiGraph::size_type affected;
+
+    Reachability(SimpleIncSSReachAlgorithm<reverseArcDirection, profiling> *p, bool r, bool sf, double maxUS)
         : parent(p), diGraph(nullptr), source(nullptr), reverse(r), searchForward(sf),
           maxUnknownStateRatio(maxUS),
           maxUSSqrt(false), maxUSLog(false), relateToReachable(false), numReachable(0U),
-          numUnreached(0UL), numRereached(0UL), numUnknown(0UL), numReached(0UL),
-          numTracebacks(0UL),
-          maxUnreached(0UL), maxRereached(0UL), maxUnknown(0UL), maxReached(0UL),
-          maxTracebacks(0UL),
-          numReReachFromSource(0U),
-          incNonTreeArc(0U), incUnReachableTail(0U), decNonTreeArc(0U), decUnReachableHead(0U) {
+          updateDistributions(false), affected(0U) {
         reachability.setDefaultValue(State::UNREACHABLE);
         pred.setDefaultValue(nullptr);
         radicalReset = parent->radicalReset;
@@ -104,23 +106,18 @@ struct SimpleIncSSReachAlgorithm<reverseArcDirection>::Reachability {
         reachability.resetAll();
         pred.resetAll();
         numReachable = 0UL;
-#ifdef COLLECT_PR_DATA
-        numUnreached = 0UL;
-        numRereached = 0UL;
-        numUnknown = 0UL;
-        numReached = 0UL;
-        numTracebacks = 0UL;
-        maxUnreached = 0UL;
-        maxRereached = 0UL;
-        maxUnknown = 0UL;
-        maxReached = 0UL;
-        maxTracebacks = 0UL;
-        numReReachFromSource = 0UL;
-        incNonTreeArc = 0U;
-        incUnReachableTail = 0U;
-        decNonTreeArc = 0U;
-        decUnReachableHead = 0U;
-#endif
+        if constexpr (profiling) {
+            counters = Counters();
+            updateDistributions.clear();
+        }
+    }
+
+    // record the work of an update since arcsBefore arcs had been considered
+    void recordUpdate(UpdateDistributions::Update update, profiling_counter arcsBefore) {
+        if constexpr (profiling) {
+            updateDistributions.record(update, { affected, parent->pr_consideredArcs - arcsBefore,
+                                                 0U, 0U });
+        }
     }
 
     template<bool collectVertices, bool setPred, bool force, bool limit = false>
@@ -146,9 +143,9 @@ struct SimpleIncSSReachAlgorithm<reverseArcDirection>::Reachability {
         bfs.onArcDiscover([this,from,s,&steps](const Arc *ca) {
             auto *a = const_cast<Arc*>(ca);
             PRINT_DEBUG("Discovering arc (" << a->getTail() << ", " << a->getHead() << ")" );
-#ifdef COLLECT_PR_DATA
-            parent->prArcConsidered();
-#endif
+            if constexpr (profiling) {
+                parent->prArcConsidered();
+            }
             auto v = reverseArcDirection ? a->getTail() : a->getHead();
 
             PRINT_DEBUG("Reaching " << v << " via " << (reverseArcDirection ? a->getHead() : a->getTail())
@@ -209,12 +206,12 @@ struct SimpleIncSSReachAlgorithm<reverseArcDirection>::Reachability {
             });
         }
 
-#ifdef COLLECT_PR_DATA
-        bfs.onVertexDiscover([this](const Vertex *) {
-            parent->prVertexConsidered();
-            return true;
-        });
-#endif
+        if constexpr (profiling) {
+            bfs.onVertexDiscover([this](const Vertex *) {
+                parent->prVertexConsidered();
+                return true;
+            });
+        }
         if (!bfs.prepare()) {
             throw DiGraphAlgorithmException(nullptr, "Could not prepare BFS algorithm.");
         }
@@ -232,12 +229,12 @@ struct SimpleIncSSReachAlgorithm<reverseArcDirection>::Reachability {
         assert(reachability(u) == State::UNKNOWN);
         visitedUnknown.push_back(u);
 
-#ifdef COLLECT_PR_DATA
-        bfs.onArcDiscover([this](const Arc *) {
-            parent->prArcConsidered();
-            return true;
-        });
-#endif
+        if constexpr (profiling) {
+            bfs.onArcDiscover([this](const Arc *) {
+                parent->prArcConsidered();
+                return true;
+            });
+        }
 
         FastPropertyMap<Arc*> succ;
         Vertex *reachableAncestor = nullptr;
@@ -246,9 +243,9 @@ struct SimpleIncSSReachAlgorithm<reverseArcDirection>::Reachability {
 
             auto v = reverseArcDirection ? a->getHead() : a->getTail();
 
-#ifdef COLLECT_PR_DATA
-            parent->prVertexConsidered();
-#endif
+            if constexpr (profiling) {
+                parent->prVertexConsidered();
+            }
 
             PRINT_DEBUG("Exploring " << v->getName() << " with state " << printState(reachability(v))
                         << " via " << (reverseArcDirection ? a->getHead() : a->getTail()));
@@ -286,9 +283,9 @@ struct SimpleIncSSReachAlgorithm<reverseArcDirection>::Reachability {
                 a = succ[t];
                 assert(a != nullptr);
                 h = reverseArcDirection ? a->getTail() : a->getHead();
-#ifdef COLLECT_PR_DATA
-                parent->prVertexConsidered();
-#endif
+                if constexpr (profiling) {
+                    parent->prVertexConsidered();
+                }
                 pred[h] = a;
                 reachability[h] = State::REACHABLE;
                 numReachable++;
@@ -302,15 +299,14 @@ struct SimpleIncSSReachAlgorithm<reverseArcDirection>::Reachability {
 
     template<bool force = false>
     void reachFrom(const Vertex *from) {
-#ifdef COLLECT_PR_DATA
-        auto reached = propagate<false,true,force>(from, State::REACHABLE);
-        if (reached > maxReached) {
-            maxReached = reached;
+        [[maybe_unused]] auto reached = propagate<false,true,force>(from, State::REACHABLE);
+        if constexpr (profiling) {
+            if (reached > counters.maxReached) {
+                counters.maxReached = reached;
+            }
+            counters.numReached += reached;
+            affected += reached;
         }
-        numReached += reached;
-#else
-        propagate<false,true,force>(from, State::REACHABLE);
-#endif
     }
 
     void unReachFrom(const Vertex *from) {
@@ -320,13 +316,14 @@ struct SimpleIncSSReachAlgorithm<reverseArcDirection>::Reachability {
 
         if (!maxUSSqrt && !maxUSLog && maxUnknownStateRatio == 0.0) {
             PRINT_DEBUG("Maximum allowed unknown state ratio is 0, recomputing immediately.");
+            PhaseCounter counter(parent, Phase::Rerun);
             reachability.resetAll();
             pred.resetAll();
             numReachable = 0U;
-#ifdef COLLECT_PR_DATA
-            numReReachFromSource++;
-            parent->prReset();
-#endif
+            if constexpr (profiling) {
+                counters.numReReachFromSource++;
+                parent->prReset();
+            }
             reachFrom<false>(source);
             return;
         }
@@ -347,21 +344,23 @@ struct SimpleIncSSReachAlgorithm<reverseArcDirection>::Reachability {
 
         auto unknown = changedStateVertices.size();
         numReachable -= unknown;
-#ifdef COLLECT_PR_DATA
-        PRINT_DEBUG( unknown << " vertices have unknown state.");
+        if constexpr (profiling) {
+            affected += unknown;
+            PRINT_DEBUG( unknown << " vertices have unknown state.");
 #ifndef NDEBUG
-        PRINT_DEBUG( visited << " were visited by BFS.");
-#endif
+            PRINT_DEBUG( visited << " were visited by BFS.");
 #endif
+        }
         assert (unknown == visited || unknown == visited + 1U);
 
         if (unknown > compareTo) {
             PRINT_DEBUG("Maximum allowed unknown state ratio exceeded, "
                         << unknown << " > " << compareTo << ", recomputing.");
-#ifdef COLLECT_PR_DATA
-            numReReachFromSource++;
-            parent->prReset();
-#endif
+            PhaseCounter counter(parent, Phase::Rerun);
+            if constexpr (profiling) {
+                counters.numReReachFromSource++;
+                parent->prReset();
+            }
 
             if (radicalReset) {
                 reachability.resetAll();
@@ -371,9 +370,9 @@ struct SimpleIncSSReachAlgorithm<reverseArcDirection>::Reachability {
             } else {
                 reachFrom<true>(source);
                 for (auto v : changedStateVertices) {
-#ifdef COLLECT_PR_DATA
-                    parent->prVertexConsidered();
-#endif
+                    if constexpr (profiling) {
+                        parent->prVertexConsidered();
+                    }
                     if (reachability(v) != State::REACHABLE) {
                         PRINT_DEBUG("Setting remaining vertex " << v
                                     << " with unknown state unreachable.");
@@ -385,20 +384,18 @@ struct SimpleIncSSReachAlgorithm<reverseArcDirection>::Reachability {
             return;
         }
 
-#ifdef COLLECT_PR_DATA
-        auto rereached = 0UL;
-        auto tracebacks = 0UL;
-#endif
+        [[maybe_unused]] auto rereached = 0UL;
+        [[maybe_unused]] auto tracebacks = 0UL;
         std::vector<const Vertex*> backwardsReached;
 
         auto processUnknowns = [&](const Vertex *u) {
-#ifdef COLLECT_PR_DATA
-             parent->prVertexConsidered();
-#endif
+             if constexpr (profiling) {
+                 parent->prVertexConsidered();
+             }
             if (reachability(u) == State::UNKNOWN) {
-#ifdef COLLECT_PR_DATA
-                tracebacks++;
-#endif
+                if constexpr (profiling) {
+                    tracebacks++;
+                }
                 backwardsReached.clear();
                 if (checkReachability(u, backwardsReached)) {
                     PRINT_DEBUG( u << " is reachable.");
@@ -417,11 +414,11 @@ struct SimpleIncSSReachAlgorithm<reverseArcDirection>::Reachability {
                     backwardsReached.clear();
                 }
             }
-#ifdef COLLECT_PR_DATA
-            if (reachability(u) == State::REACHABLE) {
-                rereached++;
+            if constexpr (profiling) {
+                if (reachability(u) == State::REACHABLE) {
+                    rereached++;
+                }
             }
-#endif
         };
 
         if (reverse) {
@@ -434,26 +431,26 @@ struct SimpleIncSSReachAlgorithm<reverseArcDirection>::Reachability {
         changedStateVertices.clear();
 
 
-#ifdef COLLECT_PR_DATA
-        assert(unknown >= rereached);
-        auto unreached = unknown - rereached;
-        numUnreached += unreached;
-        numRereached += rereached;
-        numUnknown += unknown;
-        numTracebacks += tracebacks;
-        if (maxUnreached < unreached) {
-            maxUnreached = unreached;
-        }
-        if (maxRereached < rereached) {
-            maxRereached = rereached;
-        }
-        if (maxUnknown < unknown) {
-            maxUnknown = unknown;
-        }
-        if (maxTracebacks < tracebacks) {
-            maxTracebacks = tracebacks;
+        if constexpr (profiling) {
+            assert(unknown >= rereached);
+            auto unreached = unknown - rereached;
+            counters.numUnreached += unreached;
+            counters.numRereached += rereached;
+            counters.numUnknown += unknown;
+            counters.numTracebacks += tracebacks;
+            if (counters.maxUnreached < unreached) {
+                counters.maxUnreached = unreached;
+            }
+            if (counters.maxRereached < rereached) {
+                counters.maxRereached = rereached;
+            }
+            if (counters.maxUnknown < unknown) {
+                counters.maxUnknown = unknown;
+            }
+            if (counters.maxTracebacks < tracebacks) {
+                counters.maxTracebacks = tracebacks;
+            }
         }
-#endif
     }
 
     bool reachable(const Vertex *v) const {
@@ -469,9 +466,9 @@ struct SimpleIncSSReachAlgorithm<reverseArcDirection>::Reachability {
 
     char printState(const State &s) const {
         switch (s) {
-        case SimpleIncSSReachAlgorithm<reverseArcDirection>::Reachability::State::REACHABLE:
+        case SimpleIncSSReachAlgorithm<reverseArcDirection, profiling>::Reachability::State::REACHABLE:
             return 'R';
-        case SimpleIncSSReachAlgorithm<reverseArcDirection>::Reachability::State::UNREACHABLE:
+        case SimpleIncSSReachAlgorithm<reverseArcDirection, profiling>::Reachability::State::UNREACHABLE:
             return 'U';
         default:
             return '?';
@@ -520,16 +517,16 @@ struct SimpleIncSSReachAlgorithm<reverseArcDirection>::Reachability {
 };
 
 
-template<bool reverseArcDirection>
-SimpleIncSSReachAlgorithm<reverseArcDirection>::SimpleIncSSReachAlgorithm(bool reverse, bool searchForward,
+template<bool reverseArcDirection, bool profiling>
+SimpleIncSSReachAlgorithm<reverseArcDirection, profiling>::SimpleIncSSReachAlgorithm(bool reverse, bool searchForward,
                                                      double maxUS, bool radicalReset)
-    : SimpleIncSSReachAlgorithm<reverseArcDirection>({reverse, searchForward, maxUS, radicalReset,
+    : SimpleIncSSReachAlgorithm<reverseArcDirection, profiling>({reverse, searchForward, maxUS, radicalReset,
                                                 false, false, false})
 { }
 
-template<bool reverseArcDirection>
-SimpleIncSSReachAlgorithm<reverseArcDirection>::SimpleIncSSReachAlgorithm(
-        const SimpleIncSSReachAlgorithm<reverseArcDirection>::ParameterSet &params)
+template<bool reverseArcDirection, bool profiling>
+SimpleIncSSReachAlgorithm<reverseArcDirection, profiling>::SimpleIncSSReachAlgorithm(
+        const SimpleIncSSReachAlgorithm<reverseArcDirection, profiling>::ParameterSet &params)
     : DynamicSingleSourceReachabilityAlgorithm(), initialized(false),
       reverse(std::get<0>(params)), searchForward(std::get<1>(params)),
       maxUnknownStateRatio(std::get<2>(params)),
@@ -540,35 +537,35 @@ SimpleIncSSReachAlgorithm<reverseArcDirection>::SimpleIncSSReachAlgorithm(
     registerEvents(false, true, true, true);
 }
 
-template<bool reverseArcDirection>
-SimpleIncSSReachAlgorithm<reverseArcDirection>::~SimpleIncSSReachAlgorithm()
+template<bool reverseArcDirection, bool profiling>
+SimpleIncSSReachAlgorithm<reverseArcDirection, profiling>::~SimpleIncSSReachAlgorithm()
 {
     delete data;
 }
 
-template<bool reverseArcDirection>
-void SimpleIncSSReachAlgorithm<reverseArcDirection>::setMaxUnknownStateSqrt()
+template<bool reverseArcDirection, bool profiling>
+void SimpleIncSSReachAlgorithm<reverseArcDirection, profiling>::setMaxUnknownStateSqrt()
 {
     maxUSSqrt = true;
     data->maxUSSqrt = true;
 }
 
-template<bool reverseArcDirection>
-void SimpleIncSSReachAlgorithm<reverseArcDirection>::setMaxUnknownStateLog()
+template<bool reverseArcDirection, bool profiling>
+void SimpleIncSSReachAlgorithm<reverseArcDirection, profiling>::setMaxUnknownStateLog()
 {
     maxUSLog = true;
     data->maxUSLog = true;
 }
 
-template<bool reverseArcDirection>
-void SimpleIncSSReachAlgorithm<reverseArcDirection>::relateToReachableVertices(bool relReachable)
+template<bool reverseArcDirection, bool profiling>
+void SimpleIncSSReachAlgorithm<reverseArcDirection, profiling>::relateToReachableVertices(bool relReachable)
 {
     relateToReachable = relReachable;
     data->relateToReachable = relReachable;
 }
 
-template<bool reverseArcDirection>
-void SimpleIncSSReachAlgorithm<reverseArcDirection>::run()
+template<bool reverseArcDirection, bool profiling>
+void SimpleIncSSReachAlgorithm<reverseArcDirection, profiling>::run()
 {
     if (initialized) {
         return;
@@ -579,8 +576,8 @@ void SimpleIncSSReachAlgorithm<reverseArcDirection>::run()
     initialized = true;
 }
 
-template<bool reverseArcDirection>
-std::string SimpleIncSSReachAlgorithm<reverseArcDirection>::getName() const noexcept {
+template<bool reverseArcDirection, bool profiling>
+std::string SimpleIncSSReachAlgorithm<reverseArcDirection, profiling>::getName() const noexcept {
     std::stringstream ss;
     ss << (reverseArcDirection ? "Simple Incremental Single-Sink Reachability Algorithm ("
                        : "Simple Incremental Single-Source Reachability Algorithm (")
@@ -598,8 +595,8 @@ std::string SimpleIncSSReachAlgorithm<reverseArcDirection>::getName() const noex
     return ss.str();
 }
 
-template<bool reverseArcDirection>
-std::string SimpleIncSSReachAlgorithm<reverseArcDirection>::getShortName() const noexcept {
+template<bool reverseArcDirection, bool profiling>
+std::string SimpleIncSSReachAlgorithm<reverseArcDirection, profiling>::getShortName() const noexcept {
     std::stringstream ss;
     ss << (reverseArcDirection ? "Reverse-Simple-ISSR(" : "Simple-ISSR(")
        << (reverse ? "R" : "NR") << "/"
@@ -616,82 +613,97 @@ std::string SimpleIncSSReachAlgorithm<reverseArcDirection>::getShortName() const
     return ss.str();
 }
 
-template<bool reverseArcDirection>
-std::string SimpleIncSSReachAlgorithm<reverseArcDirection>::getProfilingInfo() const
+template<bool reverseArcDirection, bool profiling>
+std::string SimpleIncSSReachAlgorithm<reverseArcDirection, profiling>::getProfilingInfo() const
 {
     std::stringstream ss;
-#ifdef COLLECT_PR_DATA
-    ss << DynamicSingleSourceReachabilityAlgorithm::getProfilingInfo();
-    ss << "total reached vertices: " << data->numReached << std::endl;
-    ss << "total unknown state vertices: " << data->numUnknown << std::endl;
-    ss << "total unreached vertices: " << data->numUnreached << std::endl;
-    ss << "total rereached vertices: " << data->numRereached << std::endl;
-    ss << "total tracebacks: " << data->numTracebacks << std::endl;
-    ss << "maximum reached vertices: " << data->maxReached << std::endl;
-    ss << "maximum unreached vertices: " << data->maxUnreached << std::endl;
-    ss << "maximum rereached vertices: " << data->maxRereached << std::endl;
-    ss << "maximum unknown state vertices: " << data->maxUnknown << std::endl;
-    ss << "maximum tracebacks: " << data->maxTracebacks << std::endl;
-    ss << "unknown state limit: " << data->maxUnknownStateRatio << std::endl;
-    ss << "#rereach from source: " << data->numReReachFromSource << std::endl;
-    ss << "#unreachable head (dec): " << data->decUnReachableHead << std::endl;
-    ss << "#non-tree arcs (dec): " << data->decNonTreeArc << std::endl;
-    ss << "#unreachable tail (inc): " << data->incUnReachableTail << std::endl;
-    ss << "#non-tree arcs (inc): " << data->incNonTreeArc << std::endl;
-#endif
+    if constexpr (profiling) {
+        ss << DynamicSingleSourceReachabilityAlgorithm::getProfilingInfo();
+        ss << "total reached vertices: " << data->counters.numReached << std::endl;
+        ss << "total unknown state vertices: " << data->counters.numUnknown << std::endl;
+        ss << "total unreached vertices: " << data->counters.numUnreached << std::endl;
+        ss << "total rereached vertices: " << data->counters.numRereached << std::endl;
+        ss << "total tracebacks: " << data->counters.numTracebacks << std::endl;
+        ss << "maximum reached vertices: " << data->counters.maxReached << std::endl;
+        ss << "maximum unreached vertices: " << data->counters.maxUnreached << std::endl;
+        ss << "maximum rereached vertices: " << data->counters.maxRereached << std::endl;
+        ss << "maximum unknown state vertices: " << data->counters.maxUnknown << std::endl;
+        ss << "maximum tracebacks: " << data->counters.maxTracebacks << std::endl;
+        ss << "unknown state limit: " << data->maxUnknownStateRatio << std::endl;
+        ss << "#rereach from source: " << data->counters.numReReachFromSource << std::endl;
+        ss << "#unreachable head (dec): " << data->counters.decUnReachableHead << std::endl;
+        ss << "#non-tree arcs (dec): " << data->counters.decNonTreeArc << std::endl;
+        ss << "#unreachable tail (inc): " << data->counters.incUnReachableTail << std::endl;
+        ss << "#non-tree arcs (inc): " << data->counters.incNonTreeArc << std::endl;
+    }
     return ss.str();
 }
 
-template<bool reverseArcDirection>
-DynamicSingleSourceReachabilityAlgorithm::Profile SimpleIncSSReachAlgorithm<reverseArcDirection>::getProfile() const
+template<bool reverseArcDirection, bool profiling>
+DynamicSingleSourceReachabilityAlgorithm::Profile SimpleIncSSReachAlgorithm<reverseArcDirection, profiling>::getProfile() const
 {
     auto profile = DynamicSingleSourceReachabilityAlgorithm::getProfile();
-    profile.push_back(std::make_pair(std::string("total_reached"), data->numReached));
-    profile.push_back(std::make_pair(std::string("total_unknown"), data->numUnknown));
-    profile.push_back(std::make_pair(std::string("total_unreached"), data->numUnreached));
-    profile.push_back(std::make_pair(std::string("total_rereached"), data->numRereached));
-    profile.push_back(std::make_pair(std::string("total_tracebacks"), data->numTracebacks));
-    profile.push_back(std::make_pair(std::string("max_reached"), data->maxReached));
-    profile.push_back(std::make_pair(std::string("max_unknown"), data->maxUnknown));
-    profile.push_back(std::make_pair(std::string("max_unreached"), data->maxUnreached));
-    profile.push_back(std::make_pair(std::string("max_rereached"), data->maxRereached));
-    profile.push_back(std::make_pair(std::string("max_tracebacks"), data->maxTracebacks));
     profile.push_back(std::make_pair(std::string("unknown_limit_percent"),
                                      data->maxUnknownStateRatio * 100));
-    profile.push_back(std::make_pair(std::string("rereach_from_source"),
-                                     data->numReReachFromSource));
-    profile.push_back(std::make_pair(std::string("dec_head_unreachable"),
-                                     data->decUnReachableHead));
-    profile.push_back(std::make_pair(std::string("dec_nontree"), data->decNonTreeArc));
-    profile.push_back(std::make_pair(std::string("inc_tail_unreachable"),
-                                     data->incUnReachableTail));
-    profile.push_back(std::make_pair(std::string("inc_nontree"), data->incNonTreeArc));
+    if constexpr (profiling) {
+        profile.push_back(std::make_pair(std::string("total_reached"), data->counters.numReached));
+        profile.push_back(std::make_pair(std::string("total_unknown"), data->counters.numUnknown));
+        profile.push_back(std::make_pair(std::string("total_unreached"), data->counters.numUnreached));
+        profile.push_back(std::make_pair(std::string("total_rereached"), data->counters.numRereached));
+        profile.push_back(std::make_pair(std::string("total_tracebacks"), data->counters.numTracebacks));
+        profile.push_back(std::make_pair(std::string("max_reached"), data->counters.maxReached));
+        profile.push_back(std::make_pair(std::string("max_unknown"), data->counters.maxUnknown));
+        profile.push_back(std::make_pair(std::string("max_unreached"), data->counters.maxUnreached));
+        profile.push_back(std::make_pair(std::string("max_rereached"), data->counters.maxRereached));
+        profile.push_back(std::make_pair(std::string("max_tracebacks"), data->counters.maxTracebacks));
+        profile.push_back(std::make_pair(std::string("rereach_from_source"),
+                                         data->counters.numReReachFromSource));
+        profile.push_back(std::make_pair(std::string("dec_head_unreachable"),
+                                         data->counters.decUnReachableHead));
+        profile.push_back(std::make_pair(std::string("dec_nontree"), data->counters.decNonTreeArc));
+        profile.push_back(std::make_pair(std::string("inc_tail_unreachable"),
+                                         data->counters.incUnReachableTail));
+        profile.push_back(std::make_pair(std::string("inc_nontree"), data->counters.incNonTreeArc));
+        data->updateDistributions.addTo(profile);
+    }
 
     return profile;
 }
 
-template<bool reverseArcDirection>
-void SimpleIncSSReachAlgorithm<reverseArcDirection>::onDiGraphSet()
+template<bool reverseArcDirection, bool profiling>
+void SimpleIncSSReachAlgorithm<reverseArcDirection, profiling>::onDiGraphSet()
 {
     DynamicSingleSourceReachabilityAlgorithm::onDiGraphSet();
     data->reset();
     data->diGraph = diGraph;
 }
 
-template<bool reverseArcDirection>
-void SimpleIncSSReachAlgorithm<reverseArcDirection>::onDiGraphUnset() {
+template<bool reverseArcDirection, bool profiling>
+void SimpleIncSSReachAlgorithm<reverseArcDirection, profiling>::onDiGraphUnset() {
     initialized = false;
     DynamicSingleSourceReachabilityAlgorithm::onDiGraphUnset();
 }
 
-template<bool reverseArcDirection>
-void SimpleIncSSReachAlgorithm<reverseArcDirection>::onVertexAdd(Vertex *)
+template<bool reverseArcDirection, bool profiling>
+void SimpleIncSSReachAlgorithm<reverseArcDirection, profiling>::onGraphRebuilt(const VertexRemapping &remap)
+{
+    remapSource(remap);
+    initialized = false;
+    releaseMemory(data->reachability);
+    releaseMemory(data->pred);
+    data->changedStateVertices.clear();
+    data->changedStateVertices.shrink_to_fit();
+    data->source = source;
+}
+
+template<bool reverseArcDirection, bool profiling>
+void SimpleIncSSReachAlgorithm<reverseArcDirection, profiling>::onVertexAdd(Vertex *)
 {
      // vertex is unreachable
 }
 
-template<bool reverseArcDirection>
-void SimpleIncSSReachAlgorithm<reverseArcDirection>::onVertexRemove(Vertex *v)
+template<bool reverseArcDirection, bool profiling>
+void SimpleIncSSReachAlgorithm<reverseArcDirection, profiling>::onVertexRemove(Vertex *v)
 {
     if (!initialized) {
         return;
@@ -699,8 +711,8 @@ void SimpleIncSSReachAlgorithm<reverseArcDirection>::onVertexRemove(Vertex *v)
     data->removeVertex(v);
 }
 
-template<bool reverseArcDirection>
-void SimpleIncSSReachAlgorithm<reverseArcDirection>::onArcAdd(Arc *a)
+template<bool reverseArcDirection, bool profiling>
+void SimpleIncSSReachAlgorithm<reverseArcDirection, profiling>::onArcAdd(Arc *a)
 {
     if (!initialized) {
         return;
@@ -728,28 +740,35 @@ void SimpleIncSSReachAlgorithm<reverseArcDirection>::onArcAdd(Arc *a)
     }
 
     if (!data->reachable(tail)) {
-#ifdef COLLECT_PR_DATA
-        PRINT_DEBUG("Tail is unreachable.");
-        data->incUnReachableTail++;
-#endif
+        if constexpr (profiling) {
+            PRINT_DEBUG("Tail is unreachable.");
+            data->counters.incUnReachableTail++;
+            data->updateDistributions.record(UpdateDistributions::Update::NonTreeArcAdd, {});
+        }
         return;
     }
 
     if (data->reachable(head)) {
-#ifdef COLLECT_PR_DATA
-        PRINT_DEBUG("Not a tree arc.");
-        data->incNonTreeArc++;
-#endif
+        if constexpr (profiling) {
+            PRINT_DEBUG("Not a tree arc.");
+            data->counters.incNonTreeArc++;
+            data->updateDistributions.record(UpdateDistributions::Update::NonTreeArcAdd, {});
+        }
         return;
     }
 
+    [[maybe_unused]] auto arcsBefore = pr_consideredArcs;
+    data->affected = 0U;
     data->pred[head] = a;
     data->reachFrom(head);
+    if constexpr (profiling) {
+        data->recordUpdate(UpdateDistributions::Update::TreeArcAdd, arcsBefore);
+    }
     assert(data->verifyReachability());
 }
 
-template<bool reverseArcDirection>
-void SimpleIncSSReachAlgorithm<reverseArcDirection>::onArcRemove(Arc *a)
+template<bool reverseArcDirection, bool profiling>
+void SimpleIncSSReachAlgorithm<reverseArcDirection, profiling>::onArcRemove(Arc *a)
 {
     if (!initialized) {
         return;
@@ -771,26 +790,33 @@ void SimpleIncSSReachAlgorithm<reverseArcDirection>::onArcRemove(Arc *a)
     if (!data->reachable(head)) {
         // head is already unreachable, nothing to update
         PRINT_DEBUG("Head is unreachable. Stop.");
-#ifdef COLLECT_PR_DATA
-        data->decUnReachableHead++;
-#endif
+        if constexpr (profiling) {
+            data->counters.decUnReachableHead++;
+            data->updateDistributions.record(UpdateDistributions::Update::NonTreeArcRemove, {});
+        }
         return;
     }
 
     if (data->pred(head) != a) {
         PRINT_DEBUG("Not a tree arc.");
-#ifdef COLLECT_PR_DATA
-        data->decNonTreeArc++;
-#endif
+        if constexpr (profiling) {
+            data->counters.decNonTreeArc++;
+            data->updateDistributions.record(UpdateDistributions::Update::NonTreeArcRemove, {});
+        }
         return;
     }
 
+    [[maybe_unused]] auto arcsBefore = pr_consideredArcs;
+    data->affected = 0U;
     data->unReachFrom(head);
+    if constexpr (profiling) {
+        data->recordUpdate(UpdateDistributions::Update::TreeArcRemove, arcsBefore);
+    }
     assert(data->verifyReachability());
 }
 
-template<bool reverseArcDirection>
-bool SimpleIncSSReachAlgorithm<reverseArcDirection>::query(const Vertex *t)
+template<bool reverseArcDirection, bool profiling>
+bool SimpleIncSSReachAlgorithm<reverseArcDirection, profiling>::query(const Vertex *t)
 {
     if (t == source) {
         return true;
@@ -802,8 +828,8 @@ bool SimpleIncSSReachAlgorithm<reverseArcDirection>::query(const Vertex *t)
     return data->reachable(t);
 }
 
-template<bool reverseArcDirection>
-std::vector<Arc *> SimpleIncSSReachAlgorithm<reverseArcDirection>::queryPath(const Vertex *t)
+template<bool reverseArcDirection, bool profiling>
+std::vector<Arc *> SimpleIncSSReachAlgorithm<reverseArcDirection, profiling>::queryPath(const Vertex *t)
 {
     std::vector<Arc*> path;
     if (!query(t) || t == source) {
@@ -824,8 +850,8 @@ std::vector<Arc *> SimpleIncSSReachAlgorithm<reverseArcDirection>::queryPath(con
     return path;
 }
 
-template<bool reverseArcDirection>
-void SimpleIncSSReachAlgorithm<reverseArcDirection>::dumpData(std::ostream &os) const
+template<bool reverseArcDirection, bool profiling>
+void SimpleIncSSReachAlgorithm<reverseArcDirection, profiling>::dumpData(std::ostream &os) const
 {
     if (!initialized) {
         os << "uninitialized" << std::endl;
@@ -843,15 +869,17 @@ void SimpleIncSSReachAlgorithm<reverseArcDirection>::dumpData(std::ostream &os)
     }
 }
 
-template<bool reverseArcDirection>
-void SimpleIncSSReachAlgorithm<reverseArcDirection>::onSourceSet()
+template<bool reverseArcDirection, bool profiling>
+void SimpleIncSSReachAlgorithm<reverseArcDirection, profiling>::onSourceSet()
 {
     DynamicSingleSourceReachabilityAlgorithm::onSourceSet();
     initialized = false;
     data->reset(source);
 }
 
-template class SimpleIncSSReachAlgorithm<false>;
-template class SimpleIncSSReachAlgorithm<true>;
+template class SimpleIncSSReachAlgorithm<false, Profiling::Off>;
+template class SimpleIncSSReachAlgorithm<false, Profiling::On>;
+template class SimpleIncSSReachAlgorithm<true, Profiling::Off>;
+template class SimpleIncSSReachAlgorithm<true, Profiling::On>;
 
 } // namespace
@@ -27,10 +27,12 @@
 #include <sstream>
 
 #include "property/propertymap.h"
+#include "profiling/profiling.h"
 
 namespace Algora {
 
-template<bool reverseArcDirection = false>
+// profiling: collect detailed counters, see Profiling
+template<bool reverseArcDirection = false, bool profiling = Profiling::Default>
 class SimpleIncSSReachAlgorithm : public DynamicSingleSourceReachabilityAlgorithm
 {
 public:
@@ -67,6 +69,7 @@ public:
 protected:
     virtual void onDiGraphSet() override;
     virtual void onDiGraphUnset() override;
+    virtual void onGraphRebuilt(const VertexRemapping &remap) override;
 
     // DynamicSSReachAlgorithm interface
 public:
@@ -94,8 +97,10 @@ private:
 };
 
 // explicit instantiation declaration
-extern template class SimpleIncSSReachAlgorithm<false>;
-extern template class SimpleIncSSReachAlgorithm<true>;
+extern template class SimpleIncSSReachAlgorithm<false, Profiling::Off>;
+extern template class SimpleIncSSReachAlgorithm<false, Profiling::On>;
+extern template class SimpleIncSSReachAlgorithm<true, Profiling::Off>;
+extern template class SimpleIncSSReachAlgorithm<true, Profiling::On>;
 }
 
 #endif // SIMPLEINCSSREACHALGORITHM_H
@@ -2,6 +2,7 @@ message("pri file being processed: $$PWD")
 
 HEADERS += \
     $$PWD/dynamicdigraphalgorithm.h \
+    $$PWD/dynamicdigraphalgorithmgroup.h \
     $$PWD/staticalgorithmwrapper.h
 
 SOURCES += \
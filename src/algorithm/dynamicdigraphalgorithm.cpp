@@ -23,15 +23,17 @@
 #include "dynamicdigraphalgorithm.h"
 
 #include "graph/digraph.h"
+#include "graph.dyn/dynamicdigraph.h"
 #include <functional>
 #include <sstream>
+#include <stdexcept>
 
 namespace Algora {
 
 DynamicDiGraphAlgorithm::DynamicDiGraphAlgorithm()
     : DiGraphAlgorithm(),
       pr_consideredVertices(0), pr_consideredArcs(0), pr_numResets(0),
-      autoUpdate(true), registered(false),
+      dynamicDiGraph(nullptr), autoUpdate(true), registered(false), deltas(false), deltasAtOnce(false),
       registerOnVertexAdd(true), registerOnVertexRemove(true),
       registerOnArcAdd(true), registerOnArcRemove(true)
 {}
@@ -39,15 +41,165 @@ DynamicDiGraphAlgorithm::DynamicDiGraphAlgorithm()
 DynamicDiGraphAlgorithm::~DynamicDiGraphAlgorithm()
 {
     deregisterAsObserver();
+    if (dynamicDiGraph) {
+        autoUpdate = false;
+        dynamicDiGraph->removeOnDelta(this);
+        dynamicDiGraph->removeOnDefragment(this);
+    }
+}
+
+void DynamicDiGraphAlgorithm::onDelta(const std::vector<Arc *> &addedArcs,
+                                      const std::vector<Arc *> &removedArcs,
+                                      const std::vector<Vertex *> &addedVertices,
+                                      const std::vector<Vertex *> &removedVertices)
+{
+    // timed as a whole by handleDelta(), which also leaves out unregistered kinds of changes
+    if (registerOnVertexAdd) {
+        for (auto *v : addedVertices) {
+            onVertexAdd(v);
+        }
+    }
+    if (registerOnArcAdd) {
+        for (auto *a : addedArcs) {
+            onArcAdd(a);
+        }
+    }
+    if (registerOnArcRemove) {
+        for (auto *a : removedArcs) {
+            onArcRemove(a);
+        }
+    }
+    if (registerOnVertexRemove) {
+        for (auto *v : removedVertices) {
+            onVertexRemove(v);
+        }
+    }
+}
+
+void DynamicDiGraphAlgorithm::receiveDeltas(bool d)
+{
+    if (d) {
+        deregisterAsObserver();
+        deltas = true;
+    } else {
+        deltas = false;
+        registerAsObserver();
+    }
+}
+
+void DynamicDiGraphAlgorithm::recordLatencies(bool record)
+{
+    if (record && !latencies) {
+        latencies.reset(new std::array<LatencyHistogram, NUM_LATENCY_KINDS>());
+    } else if (!record) {
+        latencies.reset();
+    }
+}
+
+bool DynamicDiGraphAlgorithm::countHardwareEvents(bool count)
+{
+    if (!count) {
+        hardwareCounters.reset();
+        return true;
+    }
+    if (!hardwareCounters) {
+        std::unique_ptr<HardwareCounters> counters(new HardwareCounters);
+        if (!counters->isAvailable()) {
+            return false;
+        }
+        hardwareCounters = std::move(counters);
+        for (auto &events : hardwareEvents) {
+            events.fill(0ULL);
+        }
+    }
+    return true;
+}
+
+void DynamicDiGraphAlgorithm::addHardwareEvents(Phase phase,
+                                                const HardwareCounters::Reading &start)
+{
+    auto now = hardwareCounters->read();
+    auto &events = hardwareEvents[static_cast<unsigned int>(phase)];
+    for (unsigned int e = 0U; e < HardwareCounters::NUM_EVENTS; e++) {
+        events[e] += now[e] - start[e];
+    }
+}
+
+const LatencyHistogram &DynamicDiGraphAlgorithm::getLatencies(Latency kind) const
+{
+    if (!latencies) {
+        throw std::logic_error("Latencies are not recorded.");
+    }
+    return (*latencies)[static_cast<unsigned int>(kind)];
 }
 
 DynamicDiGraphAlgorithm::Profile DynamicDiGraphAlgorithm::getProfile() const
 {
-    return Profile {
+    Profile profile {
         std::pair(std::string("vertices_considered"), pr_consideredVertices),
                 std::pair(std::string("arcs_considered"), pr_consideredArcs),
                 std::pair(std::string("num_resets"), pr_numResets)
     };
+    if (latencies) {
+        for (unsigned int i = 0U; i < NUM_LATENCY_KINDS; i++) {
+            const auto &histogram = (*latencies)[i];
+            if (histogram.getCount() == 0ULL) {
+                continue;
+            }
+            std::string prefix = std::string(nameOf(static_cast<Latency>(i))) + "_latency_";
+            profile.emplace_back(prefix + "p50_ns", histogram.getPercentile(0.5));
+            profile.emplace_back(prefix + "p99_ns", histogram.getPercentile(0.99));
+            profile.emplace_back(prefix + "p999_ns", histogram.getPercentile(0.999));
+            profile.emplace_back(prefix + "max_ns", histogram.getMax());
+        }
+    }
+    if (hardwareCounters) {
+        for (unsigned int p = 0U; p < NUM_PHASES; p++) {
+            for (unsigned int e = 0U; e < HardwareCounters::NUM_EVENTS; e++) {
+                auto event = static_cast<HardwareCounters::Event>(e);
+                if (hardwareCounters->isAvailable(event)) {
+                    profile.emplace_back(std::string(nameOf(static_cast<Phase>(p))) + "_"
+                                         + HardwareCounters::nameOf(event),
+                                         hardwareEvents[p][e]);
+                }
+            }
+        }
+    }
+    return profile;
+}
+
+const char *DynamicDiGraphAlgorithm::nameOf(Latency kind)
+{
+    switch (kind) {
+    case Latency::VertexAdd:
+        return "vertex_add";
+    case Latency::VertexRemove:
+        return "vertex_remove";
+    case Latency::ArcAdd:
+        return "arc_add";
+    case Latency::ArcRemove:
+        return "arc_remove";
+    case Latency::Delta:
+        return "delta";
+    case Latency::Query:
+        return "query";
+    case Latency::QueryPath:
+        return "query_path";
+    }
+    return "";
+}
+
+const char *DynamicDiGraphAlgorithm::nameOf(Phase phase)
+{
+    switch (phase) {
+    case Phase::Update:
+        return "update";
+    case Phase::Query:
+        return "query";
+    case Phase::Rerun:
+        return "rerun";
+    }
+    return "";
 }
 
 std::string DynamicDiGraphAlgorithm::getProfilingInfo() const
@@ -72,26 +224,40 @@ void DynamicDiGraphAlgorithm::onDiGraphUnset()
     DiGraphAlgorithm::onDiGraphUnset();
 }
 
+void DynamicDiGraphAlgorithm::beforeGraphRebuild()
+{
+    deregisterAsObserver();
+    onGraphRebuildBegin();
+}
+
+void DynamicDiGraphAlgorithm::afterGraphRebuild(const VertexRemapping &remap)
+{
+    onGraphRebuilt(remap);
+    if (!registered) {
+        registerAsObserver();
+    }
+}
+
+void DynamicDiGraphAlgorithm::onGraphRebuilt(const VertexRemapping &)
+{
+    onDiGraphUnset();
+    onDiGraphSet();
+}
+
 void DynamicDiGraphAlgorithm::registerAsObserver()
 {
-    if (diGraph && autoUpdate) {
-        using namespace std::placeholders;  // for _1, _2, _3...
-        //auto ova = std::bind(&DynamicDiGraphAlgorithm::onVertexAdd, this, _1);
+    if (diGraph && autoUpdate && !deltas) {
         if (registerOnVertexAdd) {
-            diGraph->onVertexAdd(this,
-                                 std::bind(&DynamicDiGraphAlgorithm::onVertexAdd, this, _1));
+            diGraph->onVertexAdd(this, [this](Vertex *v) { handleVertexAdd(v); });
         }
         if (registerOnVertexRemove) {
-            diGraph->onVertexRemove(this,
-                                    std::bind(&DynamicDiGraphAlgorithm::onVertexRemove, this, _1));
+            diGraph->onVertexRemove(this, [this](Vertex *v) { handleVertexRemove(v); });
         }
         if (registerOnArcAdd) {
-            diGraph->onArcAdd(this,
-                              std::bind(&DynamicDiGraphAlgorithm::onArcAdd, this, _1));
+            diGraph->onArcAdd(this, [this](Arc *a) { handleArcAdd(a); });
         }
         if (registerOnArcRemove) {
-            diGraph->onArcRemove(this,
-                                 std::bind(&DynamicDiGraphAlgorithm::onArcRemove, this, _1));
+            diGraph->onArcRemove(this, [this](Arc *a) { handleArcRemove(a); });
         }
         registered = true;
     }
@@ -24,13 +24,22 @@
 #define DYNAMICDIGRAPHALGORITHM_H
 
 #include "algorithm/digraphalgorithm.h"
+#include "property/fastpropertymap.h"
+#include "profiling/latencyhistogram.h"
+#include "profiling/hardwarecounters.h"
+#include "profiling/tracer.h"
 
 #include <vector>
+#include <functional>
+#include <memory>
 
 namespace Algora {
 
 class Vertex;
 class Arc;
+class DynamicDiGraph;
+template<typename... Algorithms>
+class DynamicDiGraphAlgorithmGroup;
 
 class DynamicDiGraphAlgorithm
         : public DiGraphAlgorithm
@@ -38,6 +47,7 @@ class DynamicDiGraphAlgorithm
 public:
     typedef unsigned long long profiling_counter;
     typedef std::vector<std::pair<std::string, profiling_counter>> Profile;
+    typedef std::function<Vertex*(const Vertex*)> VertexRemapping;
 
     explicit DynamicDiGraphAlgorithm();
     virtual ~DynamicDiGraphAlgorithm() override;
@@ -59,6 +69,72 @@ public:
     virtual void onVertexRemove(Vertex *) { }
     virtual void onArcAdd(Arc *) { }
     virtual void onArcRemove(Arc *) { }
+    // All changes of a delta at once, see DynamicDiGraph::onDelta(). Only algorithms that
+    // receive deltas at once get them from a DynamicDiGraph, see receiveDeltasAtOnce().
+    // All added and removed arcs and vertices are contained in the graph. By default, the
+    // changes are passed on one by one, additions first, which is not the same as
+    // observing them one by one since later additions are visible earlier.
+    virtual void onDelta(const std::vector<Arc*> &addedArcs, const std::vector<Arc*> &removedArcs,
+                         const std::vector<Vertex*> &addedVertices,
+                         const std::vector<Vertex*> &removedVertices);
+    // Pass a change or delta on like the graph does to its observers, i.e., only the kinds
+    // of changes selected by registerEvents(), timed, counted and traced if enabled.
+    void handleVertexAdd(Vertex *v) {
+        if (registerOnVertexAdd) {
+            timed(Latency::VertexAdd, [this, v]() { onVertexAdd(v); });
+        }
+    }
+    void handleVertexRemove(Vertex *v) {
+        if (registerOnVertexRemove) {
+            timed(Latency::VertexRemove, [this, v]() { onVertexRemove(v); });
+        }
+    }
+    void handleArcAdd(Arc *a) {
+        if (registerOnArcAdd) {
+            timed(Latency::ArcAdd, [this, a]() { onArcAdd(a); });
+        }
+    }
+    void handleArcRemove(Arc *a) {
+        if (registerOnArcRemove) {
+            timed(Latency::ArcRemove, [this, a]() { onArcRemove(a); });
+        }
+    }
+    void handleDelta(const std::vector<Arc*> &addedArcs, const std::vector<Arc*> &removedArcs,
+                     const std::vector<Vertex*> &addedVertices,
+                     const std::vector<Vertex*> &removedVertices) {
+        timed(Latency::Delta, [&]() {
+            withRegisteredChanges(addedArcs, removedArcs, addedVertices, removedVertices,
+                                  [this](const auto &... changes) { onDelta(changes...); });
+        });
+    }
+    // Stop observing the graph since changes are passed on by a DynamicDiGraph or a
+    // DynamicDiGraphAlgorithmGroup.
+    void receiveDeltas(bool deltas);
+    bool doesReceiveDeltasAtOnce() const { return deltasAtOnce; }
+
+    // Called before and after the graph is rebuilt with new vertices and arcs, e.g., by
+    // DynamicDiGraph::defragment(). The algorithm is not notified of changes in between.
+    // remap maps a former vertex to its replacement; former vertices and arcs must not
+    // be dereferenced anymore.
+    void beforeGraphRebuild();
+    void afterGraphRebuild(const VertexRemapping &remap);
+
+    // Record the latency of each change and query in a LatencyHistogram (default: false).
+    // Changes and deltas are timed when passed on via the handle...() methods above, as
+    // done for observers of the graph, queries when issued via timedQuery() or
+    // timedQueryPath() of the subclasses. Percentiles are reported by getProfile().
+    enum class Latency { VertexAdd, VertexRemove, ArcAdd, ArcRemove, Delta, Query, QueryPath };
+    void recordLatencies(bool record);
+    bool doesRecordLatencies() const { return latencies != nullptr; }
+    const LatencyHistogram &getLatencies(Latency kind) const;
+
+    // Count hardware events (cycles, instructions, LLC misses, branch misses) of the
+    // calling thread per phase: handling changes and answering queries, timed as above,
+    // and full reruns, which are also included in the change or query causing them.
+    // Totals are reported by getProfile(). Returns false if the counters are unavailable.
+    enum class Phase { Update, Query, Rerun };
+    bool countHardwareEvents(bool count);
+    bool doesCountHardwareEvents() const { return hardwareCounters != nullptr; }
 
     virtual void dumpData(std::ostream&) const { }
     virtual Profile getProfile() const;
@@ -76,7 +152,69 @@ protected:
 
     virtual void onDiGraphSet() override;
     virtual void onDiGraphUnset() override;
+    // Around a rebuild of the graph. By default, the algorithm is reset afterwards as if
+    // the graph had been set anew.
+    virtual void onGraphRebuildBegin() { }
+    virtual void onGraphRebuilt(const VertexRemapping &remap);
+
+    // replace a property map by an empty one, releasing its memory
+    template<typename T>
+    static void releaseMemory(FastPropertyMap<T> &map) {
+        map = FastPropertyMap<T>(map.getDefaultValue());
+    }
 
+    // attributes hardware events during its lifetime to a phase, if they are counted,
+    // and traces it as event (default: the name of the phase)
+    class PhaseCounter {
+    public:
+        PhaseCounter(DynamicDiGraphAlgorithm *a, Phase p, const char *event = nullptr)
+            : algorithm(a), phase(p), trace(event ? event : nameOf(p), "algorithm") {
+            if (algorithm->hardwareCounters) {
+                start = algorithm->hardwareCounters->read();
+            }
+        }
+        ~PhaseCounter() {
+            if (algorithm->hardwareCounters) {
+                algorithm->addHardwareEvents(phase, start);
+            }
+        }
+        PhaseCounter(const PhaseCounter &) = delete;
+        PhaseCounter &operator=(const PhaseCounter &) = delete;
+
+    private:
+        DynamicDiGraphAlgorithm *algorithm;
+        Phase phase;
+        HardwareCounters::Reading start;
+        Tracer::Scope trace;
+    };
+
+    // call f, recording its latency, hardware events and trace event if enabled
+    template<typename F>
+    auto timed(Latency kind, const F &f) -> decltype(f()) {
+        if (!latencies && !hardwareCounters && !Tracer::isEnabled()) {
+            return f();
+        }
+        PhaseCounter counter(this, kind < Latency::Query ? Phase::Update : Phase::Query,
+                             nameOf(kind));
+        struct Timer {
+            LatencyHistogram *histogram;
+            LatencyHistogram::clock::time_point start;
+            ~Timer() {
+                if (histogram) {
+                    histogram->recordSince(start);
+                }
+            }
+        } timer { latencies ? &(*latencies)[static_cast<unsigned int>(kind)] : nullptr,
+                  LatencyHistogram::clock::now() };
+        return f();
+    }
+
+    // Whether onDelta() handles a delta with all of its additions already applied
+    // (default: false). Otherwise, deltas are passed on change by change as applied.
+    void receiveDeltasAtOnce(bool atOnce) { deltasAtOnce = atOnce; }
+
+    // Kinds of changes to be told about (default: all), whether by observing the graph or
+    // from a DynamicDiGraph or DynamicDiGraphAlgorithmGroup. To be set before the graph.
     void registerEvents(bool vertexAdd, bool vertexRemove, bool arcAdd, bool arcRemove) {
         registerOnVertexAdd = vertexAdd;
         registerOnVertexRemove = vertexRemove;
@@ -95,12 +233,45 @@ protected:
     }
 
 private:
+    static constexpr unsigned int NUM_LATENCY_KINDS = 7U;
+    std::unique_ptr<std::array<LatencyHistogram, NUM_LATENCY_KINDS>> latencies;
+    static constexpr unsigned int NUM_PHASES = 3U;
+    std::unique_ptr<HardwareCounters> hardwareCounters;
+    std::array<HardwareCounters::Reading, NUM_PHASES> hardwareEvents;
+
+    void addHardwareEvents(Phase phase, const HardwareCounters::Reading &start);
+    static const char *nameOf(Latency kind);
+    static const char *nameOf(Phase phase);
+
+    // the DynamicDiGraph passing on changes, see DynamicDiGraph::onDelta() and
+    // DynamicDiGraph::onDefragment(), from which the algorithm removes itself on deletion
+    DynamicDiGraph *dynamicDiGraph;
+    friend class DynamicDiGraph;
+    // times the calls to its members
+    template<typename... Algorithms>
+    friend class DynamicDiGraphAlgorithmGroup;
+
     bool autoUpdate;
     bool registered;
+    bool deltas;
+    bool deltasAtOnce;
 
     void registerAsObserver();
     void deregisterAsObserver();
 
+    // calls f with the changes of a delta, leaving out those of unregistered kinds
+    template<typename F>
+    void withRegisteredChanges(const std::vector<Arc*> &addedArcs,
+                               const std::vector<Arc*> &removedArcs,
+                               const std::vector<Vertex*> &addedVertices,
+                               const std::vector<Vertex*> &removedVertices, const F &f) const {
+        static const std::vector<Arc*> noArcs;
+        static const std::vector<Vertex*> noVertices;
+        f(registerOnArcAdd ? addedArcs : noArcs, registerOnArcRemove ? removedArcs : noArcs,
+          registerOnVertexAdd ? addedVertices : noVertices,
+          registerOnVertexRemove ? removedVertices : noVertices);
+    }
+
     bool registerOnVertexAdd;
     bool registerOnVertexRemove;
     bool registerOnArcAdd;
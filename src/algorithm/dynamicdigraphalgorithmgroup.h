@@ -0,0 +1,227 @@
+/**
+ * Copyright (C) 2013 - 2019 : Kathrin Hanauer
+ *
+ * This file is part of Algora.
+ *
+ * Algora is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Algora is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Algora.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact information:
+ *   http://algora.xaikal.org
+ */
+
+#ifndef DYNAMICDIGRAPHALGORITHMGROUP_H
+#define DYNAMICDIGRAPHALGORITHMGROUP_H
+
+#include "dynamicdigraphalgorithm.h"
+
+#include <vector>
+#include <tuple>
+#include <algorithm>
+#include <type_traits>
+
+namespace Algora {
+
+// Passes changes on to algorithms of the concrete types Algorithms... by direct,
+// non-virtual calls, so that only the group observes the graph (or receives deltas from
+// a DynamicDiGraph) instead of every member registering observers of its own.
+// Members are not owned and have to be set up on the same graph. Overrides in types
+// derived from the one a member was added as are bypassed. Members that do not auto-update
+// are skipped, as are changes of kinds a member has not registered for, see
+// registerEvents(), and each call is timed like the graph does, see handleArcAdd() etc.
+// The group receives deltas at once only if all of its members do.
+template<typename... Algorithms>
+class DynamicDiGraphAlgorithmGroup
+        : public DynamicDiGraphAlgorithm
+{
+public:
+    typedef typename std::vector<DynamicDiGraphAlgorithm*>::size_type size_type;
+
+    explicit DynamicDiGraphAlgorithmGroup() : DynamicDiGraphAlgorithm() { }
+    virtual ~DynamicDiGraphAlgorithmGroup() override = default;
+
+    // The algorithm stops observing the graph itself.
+    template<typename A>
+    void add(A *algorithm) {
+        algorithm->receiveDeltas(true);
+        membersOf<A>().push_back(algorithm);
+        updateDeltasAtOnce();
+    }
+    // The algorithm does not observe the graph again until receiveDeltas(false) is called.
+    // Changes the order of the remaining members of the same type.
+    template<typename A>
+    void remove(A *algorithm) {
+        auto &members = membersOf<A>();
+        auto pos = std::find(members.begin(), members.end(), algorithm);
+        if (pos != members.end()) {
+            *pos = members.back();
+            members.pop_back();
+        }
+        updateDeltasAtOnce();
+    }
+    void clear() {
+        std::apply([](auto &... members) { (members.clear(), ...); }, algorithms);
+        updateDeltasAtOnce();
+    }
+    size_type getSize() const {
+        return std::apply([](const auto &... members) {
+            return (size_type(0) + ... + members.size()); }, algorithms);
+    }
+
+    // DiGraphAlgorithm interface
+public:
+    virtual bool prepare() override {
+        bool prepared = DynamicDiGraphAlgorithm::prepare();
+        forEach([&prepared](auto *alg) { prepared = alg->prepare() && prepared; });
+        return prepared;
+    }
+    virtual void run() override {
+        forEach([](auto *alg) { alg->run(); });
+    }
+    virtual std::string getName() const noexcept override {
+        return "Algorithm Group";
+    }
+    virtual std::string getShortName() const noexcept override {
+        return "group";
+    }
+
+    // DynamicDiGraphAlgorithm interface
+public:
+    virtual void onVertexAdd(Vertex *v) override {
+        forEachUpdating([v](auto *alg) { vertexAdd(alg, v); });
+    }
+    virtual void onVertexRemove(Vertex *v) override {
+        forEachUpdating([v](auto *alg) { vertexRemove(alg, v); });
+    }
+    virtual void onArcAdd(Arc *a) override {
+        forEachUpdating([a](auto *alg) { arcAdd(alg, a); });
+    }
+    virtual void onArcRemove(Arc *a) override {
+        forEachUpdating([a](auto *alg) { arcRemove(alg, a); });
+    }
+    // Members that receive deltas at once get them so, all others change by change.
+    virtual void onDelta(const std::vector<Arc*> &addedArcs, const std::vector<Arc*> &removedArcs,
+                         const std::vector<Vertex*> &addedVertices,
+                         const std::vector<Vertex*> &removedVertices) override {
+        forEachUpdating([&](auto *alg) {
+            using A = std::remove_pointer_t<decltype(alg)>;
+            if (alg->doesReceiveDeltasAtOnce()) {
+                alg->timed(Latency::Delta, [&]() {
+                    alg->withRegisteredChanges(addedArcs, removedArcs, addedVertices, removedVertices,
+                                               [alg](const auto &... changes) {
+                        alg->A::onDelta(changes...);
+                    });
+                });
+                return;
+            }
+            for (auto *v : addedVertices) {
+                vertexAdd(alg, v);
+            }
+            for (auto *a : addedArcs) {
+                arcAdd(alg, a);
+            }
+            for (auto *a : removedArcs) {
+                arcRemove(alg, a);
+            }
+            for (auto *v : removedVertices) {
+                vertexRemove(alg, v);
+            }
+        });
+    }
+
+protected:
+    virtual void onGraphRebuildBegin() override {
+        forEach([](auto *alg) { alg->beforeGraphRebuild(); });
+    }
+    virtual void onGraphRebuilt(const VertexRemapping &remap) override {
+        forEach([&remap](auto *alg) { alg->afterGraphRebuild(remap); });
+    }
+
+private:
+    std::tuple<std::vector<Algorithms*>...> algorithms;
+
+    template<typename F>
+    void forEach(const F &f) {
+        std::apply([&f](auto &... members) {
+            ([&f](auto &ms) {
+                for (auto *alg : ms) {
+                    f(alg);
+                }
+            }(members), ...);
+        }, algorithms);
+    }
+
+    template<typename F>
+    void forEachUpdating(const F &f) {
+        forEach([&f](auto *alg) {
+            if (alg->doesAutoUpdate()) {
+                f(alg);
+            }
+        });
+    }
+
+    void updateDeltasAtOnce() {
+        bool atOnce = getSize() > 0;
+        forEach([&atOnce](auto *alg) { atOnce = atOnce && alg->doesReceiveDeltasAtOnce(); });
+        receiveDeltasAtOnce(atOnce);
+    }
+
+    // timed, non-virtual calls for the registered kinds of changes
+    template<typename A>
+    static void vertexAdd(A *alg, Vertex *v) {
+        if (alg->registerOnVertexAdd) {
+            alg->timed(Latency::VertexAdd, [alg, v]() { alg->A::onVertexAdd(v); });
+        }
+    }
+    template<typename A>
+    static void vertexRemove(A *alg, Vertex *v) {
+        if (alg->registerOnVertexRemove) {
+            alg->timed(Latency::VertexRemove, [alg, v]() { alg->A::onVertexRemove(v); });
+        }
+    }
+    template<typename A>
+    static void arcAdd(A *alg, Arc *a) {
+        if (alg->registerOnArcAdd) {
+            alg->timed(Latency::ArcAdd, [alg, a]() { alg->A::onArcAdd(a); });
+        }
+    }
+    template<typename A>
+    static void arcRemove(A *alg, Arc *a) {
+        if (alg->registerOnArcRemove) {
+            alg->timed(Latency::ArcRemove, [alg, a]() { alg->A::onArcRemove(a); });
+        }
+    }
+
+    // first index of A in Algorithms..., so that types may repeat
+    template<typename A, std::size_t I = 0>
+    static constexpr std::size_t indexOf() {
+        if constexpr (I == sizeof...(Algorithms)) {
+            return I;
+        } else if constexpr (std::is_same_v<A, std::tuple_element_t<I, std::tuple<Algorithms...>>>) {
+            return I;
+        } else {
+            return indexOf<A, I + 1>();
+        }
+    }
+
+    template<typename A>
+    std::vector<A*> &membersOf() {
+        constexpr auto i = indexOf<A>();
+        static_assert(i < sizeof...(Algorithms), "Not a member type of this group.");
+        return std::get<i>(algorithms);
+    }
+};
+
+}
+
+#endif // DYNAMICDIGRAPHALGORITHMGROUP_H
@@ -22,6 +22,8 @@
 
 #include "staticalgorithmwrapper.h"
 
+#include <stdexcept>
+
 namespace Algora {
 
 StaticAlgorithmWrapper::StaticAlgorithmWrapper(DiGraphAlgorithm *a,
@@ -29,7 +31,60 @@ StaticAlgorithmWrapper::StaticAlgorithmWrapper(DiGraphAlgorithm *a,
     : DynamicDiGraphAlgorithm(),
       staticAlgorithm(a),
       recomputeOnVertexAdded(rva), recomputeOnVertexRemoved(rvr),
-      recomputeOnArcAdded(raa), recomputeOnArcRemoved(rar) { }
+      recomputeOnArcAdded(raa), recomputeOnArcRemoved(rar),
+      rerunPolicy(RerunPolicy::Eager), rerunInterval(1ULL), rerunTimeBudget(0),
+      outdated(false), pendingUpdates(0ULL), lastRerun(clock::now()),
+      pr_reruns(0ULL), pr_rerunsOnAccess(0ULL), pr_deferredUpdates(0ULL) { }
+
+void StaticAlgorithmWrapper::setRerunPolicy(RerunPolicy policy)
+{
+    rerunPolicy = policy;
+    if (rerunPolicy == RerunPolicy::Eager && outdated) {
+        recompute();
+    }
+}
+
+void StaticAlgorithmWrapper::setRerunInterval(unsigned long long k)
+{
+    if (k == 0ULL) {
+        throw std::invalid_argument("Rerun interval must be positive.");
+    }
+    rerunInterval = k;
+}
+
+void StaticAlgorithmWrapper::setRerunTimeBudget(std::chrono::microseconds budget)
+{
+    rerunTimeBudget = budget;
+}
+
+DiGraphAlgorithm *StaticAlgorithmWrapper::getAlgorithm()
+{
+    if (outdated) {
+        pr_rerunsOnAccess++;
+        recompute();
+    }
+    return staticAlgorithm;
+}
+
+DynamicDiGraphAlgorithm::Profile StaticAlgorithmWrapper::getProfile() const
+{
+    auto profile = DynamicDiGraphAlgorithm::getProfile();
+    profile.push_back(std::make_pair(std::string("num_reruns"), pr_reruns));
+    profile.push_back(std::make_pair(std::string("num_reruns_on_access"), pr_rerunsOnAccess));
+    profile.push_back(std::make_pair(std::string("num_deferred_updates"), pr_deferredUpdates));
+    return profile;
+}
+
+void StaticAlgorithmWrapper::onDiGraphSet()
+{
+    DynamicDiGraphAlgorithm::onDiGraphSet();
+    staticAlgorithm->setGraph(diGraph);
+    outdated = false;
+    pendingUpdates = 0ULL;
+    pr_reruns = 0ULL;
+    pr_rerunsOnAccess = 0ULL;
+    pr_deferredUpdates = 0ULL;
+}
 
 void StaticAlgorithmWrapper::onVertexAdd(Vertex *)
 {
@@ -53,10 +108,43 @@ void StaticAlgorithmWrapper::onArcRemove(Arc *)
 
 void StaticAlgorithmWrapper::rerunIf(bool rerun)
 {
-    if (rerun) {
-       staticAlgorithm->prepare();
-       staticAlgorithm->run();
+    if (!rerun) {
+        return;
+    }
+
+    switch (rerunPolicy) {
+    case RerunPolicy::Eager:
+        recompute();
+        return;
+    case RerunPolicy::OnAccess:
+        break;
+    case RerunPolicy::EveryKUpdates:
+        if (pendingUpdates + 1 >= rerunInterval) {
+            recompute();
+            return;
+        }
+        break;
+    case RerunPolicy::TimeBudget:
+        if (clock::now() - lastRerun >= rerunTimeBudget) {
+            recompute();
+            return;
+        }
+        break;
     }
+    outdated = true;
+    pendingUpdates++;
+    pr_deferredUpdates++;
+}
+
+void StaticAlgorithmWrapper::recompute()
+{
+    PhaseCounter counter(this, Phase::Rerun);
+    staticAlgorithm->prepare();
+    staticAlgorithm->run();
+    outdated = false;
+    pendingUpdates = 0ULL;
+    lastRerun = clock::now();
+    pr_reruns++;
 }
 
 }
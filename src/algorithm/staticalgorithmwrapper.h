@@ -25,6 +25,8 @@
 
 #include "dynamicdigraphalgorithm.h"
 
+#include <chrono>
+
 namespace Algora {
 
 class StaticAlgorithmWrapper
@@ -35,20 +37,33 @@ public:
                                     bool raa = true, bool rar = true);
     virtual ~StaticAlgorithmWrapper() { delete staticAlgorithm; }
 
+    // When to rerun the static algorithm after a change it recomputes on:
+    // Eager: immediately (default); OnAccess: on the next call of getAlgorithm();
+    // EveryKUpdates: after every k-th such change; TimeBudget: at the first such change
+    // once the time budget has elapsed since the last rerun.
+    // Outdated results are recomputed on access with every policy.
+    enum class RerunPolicy { Eager, OnAccess, EveryKUpdates, TimeBudget };
+    void setRerunPolicy(RerunPolicy policy);
+    void setRerunInterval(unsigned long long k);
+    void setRerunTimeBudget(std::chrono::microseconds budget);
+    // the wrapped algorithm, rerun first if its results are outdated
+    DiGraphAlgorithm *getAlgorithm();
+    bool isOutdated() const { return outdated; }
+
     // DiGraphAlgorithm interface
 public:
     virtual bool prepare() override { return staticAlgorithm->prepare(); }
-    virtual void run() override { staticAlgorithm->run(); }
+    virtual void run() override { recompute(); }
     virtual std::string getName() const noexcept override { return "Dynamized " + staticAlgorithm->getName(); }
     virtual std::string getShortName() const noexcept override { return "dyz-" + staticAlgorithm->getShortName(); }
 
 protected:
-    virtual void onDiGraphSet() override {
-        DynamicDiGraphAlgorithm::onDiGraphSet();
-        staticAlgorithm->setGraph(diGraph);
-    }
+    virtual void onDiGraphSet() override;
 
     // DynamicDiGraphAlgorithm interface
+public:
+    virtual Profile getProfile() const override;
+
 protected:
     virtual void onVertexAdd(Vertex *) override;
     virtual void onVertexRemove(Vertex *) override;
@@ -62,7 +77,20 @@ private:
     bool recomputeOnArcAdded;
     bool recomputeOnArcRemoved;
 
+    typedef std::chrono::steady_clock clock;
+    RerunPolicy rerunPolicy;
+    unsigned long long rerunInterval;
+    std::chrono::microseconds rerunTimeBudget;
+    bool outdated;
+    unsigned long long pendingUpdates;
+    clock::time_point lastRerun;
+
+    profiling_counter pr_reruns;
+    profiling_counter pr_rerunsOnAccess;
+    profiling_counter pr_deferredUpdates;
+
     void rerunIf(bool rerun);
+    void recompute();
 };
 
 }
@@ -22,6 +22,9 @@
 
 #include "dynamicdigraph.h"
 
+#include "algorithm/dynamicdigraphalgorithm.h"
+#include "profiling/tracer.h"
+
 #include "graph.incidencelist/incidencelistgraph.h"
 #include "graph.incidencelist/incidencelistvertex.h"
 
@@ -30,6 +33,24 @@
 
 #include <stdexcept>
 #include <cassert>
+#include <algorithm>
+#include <cstdint>
+#include <array>
+#include <limits>
+#include <unordered_map>
+#include <functional>
+#include <iterator>
+#include <fstream>
+#include <deque>
+#include <memory>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define DYNDIGRAPH_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 //#define DEBUG_DYNDIGRAPH
 
@@ -45,108 +66,317 @@
 namespace Algora {
 
 struct Operation {
-    enum Type { VERTEX_ADDITION, VERTEX_REMOVAL, ARC_ADDITION, ARC_REMOVAL, MULTIPLE, NONE };
-    virtual ~Operation() {}
-    virtual void apply(IncidenceListGraph *graph) = 0;
-    virtual Type getType() const = 0;
-    virtual void reset() { }
+    enum Type : std::uint8_t { VERTEX_ADDITION, VERTEX_REMOVAL, ARC_ADDITION, ARC_REMOVAL, MULTIPLE, NONE };
+
+    // Operations are stored as a one-byte code plus an argument, which is the index of
+    // the vertex or arc record the operation refers to.
+    // Multiple operations that form a single logical operation are stored consecutively;
+    // all but the last one carry the GROUPED flag.
+    // The removal of a vertex is preceded by IMPLICIT removals of its incident arcs.
+    // They are skipped when moving forward in time, but needed to restore the arcs when
+    // moving backward.
+    // CANCELLED operations have no net effect within their delta and are skipped when
+    // replaying net deltas.
+    static constexpr std::uint8_t TYPE_MASK = 0x0F;
+    static constexpr std::uint8_t CANCELLED = 0x20;
+    static constexpr std::uint8_t IMPLICIT = 0x40;
+    static constexpr std::uint8_t GROUPED = 0x80;
+
+    static Type typeOf(std::uint8_t code) { return static_cast<Type>(code & TYPE_MASK); }
+    static bool isGrouped(std::uint8_t code) { return code & GROUPED; }
+    static bool isImplicit(std::uint8_t code) { return code & IMPLICIT; }
+    static bool isCancelled(std::uint8_t code) { return code & CANCELLED; }
 };
 
-struct OperationSet : public Operation {
-    std::vector<Operation*> operations;
-    Type type = MULTIPLE;
-
-    void clear() {
-        for (auto op : operations) {
-            delete op;
-        }
-        operations.clear();
+struct ArcKeyHash {
+    std::size_t operator()(const std::pair<DynamicDiGraph::VertexIdentifier,
+                           DynamicDiGraph::VertexIdentifier> &key) const {
+        return std::hash<DynamicDiGraph::VertexIdentifier>()(
+                    key.first * 0x9E3779B97F4A7C15ULL ^ key.second);
     }
+};
 
-    virtual ~OperationSet() override {
-        clear();
+// Array of log data. Copies share their data, which is copied before it is modified
+// while shared. Alternatively, the data may reside in a privately memory-mapped file;
+// it is then copied into memory before the array is resized.
+template<typename T>
+class LogArray {
+public:
+    typedef DynamicDiGraph::size_type size_type;
+
+    LogArray() : storage(std::make_shared<std::vector<T>>()), ptr(nullptr), len(0U) { }
+
+    size_type size() const { return len; }
+    bool empty() const { return len == 0U; }
+    const T &operator[](size_type i) const { return ptr[i]; }
+    const T &back() const { return ptr[len - 1U]; }
+    const T *data() const { return ptr; }
+    const T *begin() const { return ptr; }
+    const T *end() const { return ptr + len; }
+    const T *cbegin() const { return ptr; }
+    const T *cend() const { return ptr + len; }
+    std::reverse_iterator<const T*> rbegin() const { return std::reverse_iterator<const T*>(end()); }
+    std::reverse_iterator<const T*> rend() const { return std::reverse_iterator<const T*>(begin()); }
+    const std::vector<T> &vector() const {
+        assert(!mapping);
+        return *storage;
     }
 
-    virtual void apply(IncidenceListGraph *graph) override {
-        for (auto op : operations) {
-            op->apply(graph);
-        }
+    void set(size_type i, const T &t) {
+        modify(false);
+        ptr[i] = t;
     }
-    virtual Type getType() const override { return type; }
-    virtual void reset() override {
-        for (auto op : operations) {
-            op->reset();
-        }
+
+    T *modifiableData() {
+        modify(false);
+        return ptr;
     }
-};
 
-struct NoOperation : public Operation {
-    virtual void apply(IncidenceListGraph *) override {}
-    virtual Type getType() const override { return NONE; }
-};
+    void push_back(const T &t) {
+        modify(true);
+        storage->push_back(t);
+        update();
+    }
 
+    void resize(size_type n, const T &t) {
+        modify(true);
+        storage->resize(n, t);
+        update();
+    }
 
-struct AddVertexOperation : public Operation {
-    Vertex *vertex;
-    Vertex *constructionVertex;
-    DynamicDiGraph::VertexIdentifier vertexId;
+    void erase(const T *first, const T *last) {
+        auto from = first - ptr;
+        auto until = last - ptr;
+        modify(true);
+        storage->erase(storage->cbegin() + from, storage->cbegin() + until);
+        update();
+    }
 
-    AddVertexOperation(Vertex *cv, DynamicDiGraph::VertexIdentifier vId) : vertex(nullptr), constructionVertex(cv), vertexId(vId) { }
+    void clear() {
+        assign(std::vector<T>());
+    }
 
-    virtual void apply(IncidenceListGraph *graph) override {
-        vertex = graph->addVertex();
-        vertex->setName(std::to_string(vertexId));
+    void assign(std::vector<T> &&values) {
+        storage = std::make_shared<std::vector<T>>(std::move(values));
+        mapping.reset();
+        update();
     }
-    virtual Type getType() const override { return VERTEX_ADDITION; }
-    virtual void reset() override { vertex = nullptr; }
-};
 
-struct RemoveVertexOperation : public Operation {
-    AddVertexOperation *addOp;
+    void map(T *values, size_type n, const std::shared_ptr<void> &file) {
+        storage = std::make_shared<std::vector<T>>();
+        mapping = file;
+        ptr = values;
+        len = n;
+    }
 
-    RemoveVertexOperation(AddVertexOperation *avo) : addOp(avo) {}
+private:
+    // if mapped, storage is empty and only tells whether the mapping is shared
+    std::shared_ptr<std::vector<T>> storage;
+    std::shared_ptr<void> mapping;
+    T *ptr;
+    size_type len;
+
+    void modify(bool resize) {
+        if (mapping) {
+            if (!resize && storage.use_count() == 1) {
+                return;
+            }
+            storage = std::make_shared<std::vector<T>>(ptr, ptr + len);
+            mapping.reset();
+        } else if (storage.use_count() > 1) {
+            storage = std::make_shared<std::vector<T>>(*storage);
+        } else {
+            return;
+        }
+        update();
+    }
 
-    virtual void apply(IncidenceListGraph *graph) override {
-        graph->removeVertex(addOp->vertex);
+    void update() {
+        ptr = storage->data();
+        len = storage->size();
     }
-    virtual Type getType() const override { return VERTEX_REMOVAL; }
 };
 
-struct AddArcOperation : public Operation {
-    AddVertexOperation *tail;
-    AddVertexOperation *head;
-    Arc *arc;
-    Arc *constructionArc;
-
-    AddArcOperation(AddVertexOperation *t, AddVertexOperation *h, Arc *ca)
-        : tail(t), head(h), arc(nullptr), constructionArc(ca) { }
+template<typename T>
+T &modifiable(std::shared_ptr<T> &shared) {
+    if (shared.use_count() > 1) {
+        shared = std::make_shared<T>(*shared);
+    }
+    return *shared;
+}
 
-    virtual void apply(IncidenceListGraph *graph) override {
-        arc = graph->addArc(tail->vertex, head->vertex);
+// Static interval tree over non-empty half-open intervals [from, until) that reports
+// all intervals containing a point in O(log n + k).
+template<typename T>
+class IntervalTree {
+public:
+    typedef DynamicDiGraph::DynamicTime DynamicTime;
+    typedef DynamicDiGraph::size_type size_type;
+
+    struct Interval {
+        DynamicTime from;
+        DynamicTime until;
+        T value;
+    };
+
+    IntervalTree() : root(NONE) { }
+
+    void build(std::vector<Interval> intervals) {
+        nodes.clear();
+        byFrom.clear();
+        byUntil.clear();
+        byFrom.reserve(intervals.size());
+        byUntil.reserve(intervals.size());
+        root = buildNode(intervals);
     }
-    virtual Type getType() const override { return ARC_ADDITION; }
-    virtual void reset() override { arc = nullptr; }
-};
 
-struct RemoveArcOperation : public Operation {
-    AddArcOperation *addOp;
+    template<typename F>
+    void stab(DynamicTime t, const F &report) const {
+        auto n = root;
+        while (n != NONE) {
+            const auto &node = nodes[n];
+            if (t < node.center) {
+                for (auto i = node.begin; i < node.end && byFrom[i].from <= t; i++) {
+                    report(byFrom[i].value);
+                }
+                n = node.left;
+            } else {
+                for (auto i = node.begin; i < node.end && byUntil[i].until > t; i++) {
+                    report(byUntil[i].value);
+                }
+                n = node.right;
+            }
+        }
+    }
 
-    RemoveArcOperation(AddArcOperation *aao) : addOp(aao) { }
+private:
+    static constexpr size_type NONE = std::numeric_limits<size_type>::max();
+
+    // intervals containing center are stored at [begin, end) in byFrom and byUntil,
+    // sorted by increasing start and decreasing end, respectively
+    struct Node {
+        DynamicTime center;
+        size_type begin;
+        size_type end;
+        size_type left;
+        size_type right;
+    };
+    std::vector<Node> nodes;
+    std::vector<Interval> byFrom;
+    std::vector<Interval> byUntil;
+    size_type root;
+
+    size_type buildNode(std::vector<Interval> &intervals) {
+        if (intervals.empty()) {
+            return NONE;
+        }
+        // the median start is contained in its interval, so each node stores at least one
+        auto median = intervals.begin() + static_cast<long>(intervals.size() / 2U);
+        std::nth_element(intervals.begin(), median, intervals.end(),
+                         [](const Interval &lhs, const Interval &rhs) { return lhs.from < rhs.from; });
+        Node node { median->from, byFrom.size(), byFrom.size(), NONE, NONE };
+        std::vector<Interval> left;
+        std::vector<Interval> right;
+        for (const auto &i : intervals) {
+            if (i.until <= node.center) {
+                left.push_back(i);
+            } else if (i.from > node.center) {
+                right.push_back(i);
+            } else {
+                byFrom.push_back(i);
+            }
+        }
+        intervals.clear();
+        intervals.shrink_to_fit();
+        node.end = byFrom.size();
+        std::sort(byFrom.begin() + static_cast<long>(node.begin), byFrom.end(),
+                  [](const Interval &lhs, const Interval &rhs) { return lhs.from < rhs.from; });
+        byUntil.insert(byUntil.end(), byFrom.begin() + static_cast<long>(node.begin), byFrom.end());
+        std::sort(byUntil.begin() + static_cast<long>(node.begin), byUntil.end(),
+                  [](const Interval &lhs, const Interval &rhs) { return lhs.until > rhs.until; });
+
+        auto n = nodes.size();
+        nodes.push_back(node);
+        auto l = buildNode(left);
+        nodes[n].left = l;
+        auto r = buildNode(right);
+        nodes[n].right = r;
+        return n;
+    }
+};
 
-    virtual void apply(IncidenceListGraph *graph) override {
-        graph->removeArc(addOp->arc);
+// Binary log format: a header followed by one section per array, in the order of
+// LogSection. Sections start at multiples of SECTION_ALIGNMENT bytes; all values are
+// stored in native byte order.
+enum LogSection { OFFSETS, TYPE_COUNTS, OP_CODES, OP_ARGS, ANTEDATED, VERTEX_RECORD_IDS,
+                  ARC_RECORD_TAILS, ARC_RECORD_HEADS, VERTEX_SLOTS, SLOT_IDS, TIMESTAMPS,
+                  NUM_SECTIONS };
+
+struct LogHeader {
+    static constexpr char MAGIC[8] = { 'A', 'L', 'G', 'O', 'D', 'Y', 'N', '\0' };
+    static constexpr std::uint32_t VERSION = 1U;
+    static constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304U;
+    static constexpr std::uint32_t DENSE_IDS = 0x1U;
+    static constexpr std::uint64_t SECTION_ALIGNMENT = 64U;
+
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byteOrder;
+    std::uint32_t sizeOfSizeType;
+    std::uint32_t sizeOfVertexIdentifier;
+    std::uint32_t sizeOfDynamicTime;
+    std::uint32_t flags;
+    std::uint64_t curVertexSize;
+    std::uint64_t curArcSize;
+    std::uint64_t maxVertexSize;
+    std::uint64_t maxArcSize;
+    std::uint64_t nextFreeId;
+    std::uint64_t typeCounts[Operation::NONE + 1];
+    std::uint64_t sectionLengths[NUM_SECTIONS];
+
+    static std::uint64_t align(std::uint64_t pos) {
+        return (pos + SECTION_ALIGNMENT - 1U) / SECTION_ALIGNMENT * SECTION_ALIGNMENT;
     }
-    virtual Type getType() const override { return ARC_REMOVAL; }
 };
+constexpr char LogHeader::MAGIC[8];
 
 struct DynamicDiGraph::CheshireCat {
+    static constexpr DynamicDiGraph::size_type NO_RECORD =
+            std::numeric_limits<DynamicDiGraph::size_type>::max();
+
     IncidenceListGraph dynGraph;
     IncidenceListGraph constructionGraph;
 
-    std::vector<DynamicTime> timestamps;
-    std::vector<Operation*> operations;
-    std::vector<DynamicDiGraph::size_type> offset;
-    OperationSet antedated;
+    LogArray<DynamicTime> timestamps;
+    LogArray<DynamicDiGraph::size_type> offset;
+
+    // operation log
+    LogArray<std::uint8_t> opCodes;
+    LogArray<DynamicDiGraph::size_type> opArgs;
+    LogArray<DynamicDiGraph::size_type> antedated;
+
+    // number of explicit operations per type before each delta and in total
+    typedef std::array<DynamicDiGraph::size_type, Operation::NONE + 1> TypeCounts;
+    LogArray<TypeCounts> typeCountsBefore;
+    TypeCounts typeCounts;
+
+    // one record per vertex addition
+    LogArray<VertexIdentifier> vertexRecordIds;
+    std::vector<Vertex*> vertexRecordVertices;
+    std::vector<Vertex*> vertexRecordConstructionVertices;
+    // current vertex per slot, i.e., per vertex id, if any
+    std::vector<Vertex*> slotVertices;
+
+    // one record per arc addition, tail and head refer to vertex records
+    LogArray<DynamicDiGraph::size_type> arcRecordTails;
+    LogArray<DynamicDiGraph::size_type> arcRecordHeads;
+    std::vector<Arc*> arcRecordArcs;
+    std::vector<Arc*> arcRecordConstructionArcs;
+
+    // replace the construction graph in lightweight mode
+    std::vector<DiGraph::size_type> vertexRecordDegrees;
+    std::vector<std::vector<DynamicDiGraph::size_type>> vertexRecordIncidentArcs;
+    std::vector<bool> arcRecordConstructed;
 
     DynamicDiGraph::size_type timeIndex;
     DynamicDiGraph::size_type opIndex;
@@ -154,11 +384,106 @@ struct DynamicDiGraph::CheshireCat {
 
     bool doubleArcIsRemoval;
 
-    std::vector<AddVertexOperation*> vertices;
-    FastPropertyMap<AddArcOperation*> constructionArcMap;
-
-    FastPropertyMap<VertexIdentifier> vertexToIdMap;
-    DynamicDiGraph::size_type vertexToIdMapNextOpIndex;
+    // slot of a vertex id -> current vertex record;
+    // slots are the ids themselves unless dense ids are enabled
+    LogArray<DynamicDiGraph::size_type> vertices;
+    typedef std::unordered_map<VertexIdentifier, DynamicDiGraph::size_type> DenseIdMap;
+    std::shared_ptr<DenseIdMap> denseIdMap;
+    LogArray<VertexIdentifier> slotIds;
+    FastPropertyMap<DynamicDiGraph::size_type> constructionArcMap;
+
+    // (tailId, headId) -> arc records of all current arcs between these vertices
+    typedef std::pair<VertexIdentifier, VertexIdentifier> ArcKey;
+    std::unordered_multimap<ArcKey, DynamicDiGraph::size_type, ArcKeyHash> arcIndex;
+    bool arcIndexEnabled;
+    bool lightweightConstruction;
+    bool denseIds;
+    VertexIdentifier nextFreeId;
+    bool nameVertices;
+
+    // net delta replay: number of leading deltas that have been canonicalized, and
+    // cancelled re-additions of arcs (op index) -> cancelled removal (op index) whose arc they take over
+    bool netDeltas;
+    DynamicDiGraph::size_type numCanonicalDeltas;
+    // number of logical operations of the delta at lastDeltaSizeIndex ending before
+    // lastDeltaSizeEnd, recorded when it is applied; invalid if lastDeltaSizeIndex is NO_RECORD
+    DynamicDiGraph::size_type lastDeltaSize;
+    DynamicDiGraph::size_type lastDeltaSizeIndex;
+    DynamicDiGraph::size_type lastDeltaSizeEnd;
+    typedef std::unordered_map<DynamicDiGraph::size_type, DynamicDiGraph::size_type> TransferMap;
+    std::shared_ptr<TransferMap> netTransfers;
+
+    // online mode: operations are applied when added and discarded afterwards;
+    // records of removed vertices and arcs are reused
+    bool online;
+    DynamicDiGraph::size_type numDiscardedOps;
+    std::vector<DynamicDiGraph::size_type> freeVertexRecords;
+    std::vector<DynamicDiGraph::size_type> freeArcRecords;
+
+    // sliding window: arcs expire windowLength time units after their addition;
+    // queue of (expiry time, arc record), valid if the record's arc still has this expiry
+    DynamicTime windowLength;
+    std::vector<DynamicTime> arcRecordExpiry;
+    std::deque<std::pair<DynamicTime, DynamicDiGraph::size_type>> expiryQueue;
+    // the construction state keeps expired arcs, as the log does not depend on the window,
+    // but tracks which of them have expired by the final time
+    std::vector<DynamicTime> arcRecordAdditionTimes;
+    std::vector<bool> arcRecordConstructionExpired;
+    std::deque<std::pair<DynamicTime, DynamicDiGraph::size_type>> constructionExpiryQueue;
+    DiGraph::size_type numExpiredArcs;
+
+    // temporal index, built on demand: lifetimes [from, until) of the arcs between two
+    // vertices, disjoint and sorted, and per vertex slot the lifetimes of the arcs to its
+    // out- and in-neighbors
+    typedef std::pair<DynamicTime, DynamicTime> Lifetime;
+    std::unordered_map<ArcKey, std::vector<Lifetime>, ArcKeyHash> arcLifetimes;
+    std::vector<IntervalTree<VertexIdentifier>> outNeighborLifetimes;
+    std::vector<IntervalTree<VertexIdentifier>> inNeighborLifetimes;
+    bool temporalIndexValid;
+
+    // a loaded log's construction state is only restored when operations are added
+    bool constructionStateStale;
+    std::shared_ptr<void> mappedLog;
+
+    // algorithms to notify when dynGraph is rebuilt by defragment()
+    std::vector<DynamicDiGraphAlgorithm*> defragmentListeners;
+
+    // algorithms that receive the changes of dynGraph from here instead of observing it:
+    // deltas applied by nextDelta() at once if all of them receive deltas at once,
+    // all other changes one by one; removals within a delta collected at once are
+    // carried out after the listeners have been notified
+    std::vector<DynamicDiGraphAlgorithm*> deltaListeners;
+    struct Delta {
+        std::vector<Arc*> addedArcs;
+        std::vector<Arc*> removedArcs;
+        std::vector<Vertex*> addedVertices;
+        std::vector<Vertex*> removedVertices;
+    };
+    Delta delta;
+    bool collectingDelta;
+    bool notificationsSuspended;
+
+    // records of the vertices and arcs in dynGraph;
+    // a record's vertex or arc is non-null iff it is currently contained in dynGraph
+    FastPropertyMap<DynamicDiGraph::size_type> dynVertexRecords;
+    FastPropertyMap<DynamicDiGraph::size_type> dynArcRecords;
+
+    // state of dynGraph after applying all operations before opIndex
+    struct Checkpoint {
+        DynamicDiGraph::size_type timeIndex;
+        DynamicDiGraph::size_type opIndex;
+        std::vector<DynamicDiGraph::size_type> vertexRecords;
+        std::vector<DynamicDiGraph::size_type> arcRecords;
+
+        DynamicDiGraph::size_type memoryUsage() const {
+            return sizeof(Checkpoint) + (vertexRecords.capacity() + arcRecords.capacity())
+                    * sizeof(DynamicDiGraph::size_type);
+        }
+    };
+    std::vector<Checkpoint> checkpoints;
+    DynamicDiGraph::size_type checkpointInterval;
+    DynamicDiGraph::size_type checkpointMemoryBudget;
+    DynamicDiGraph::size_type checkpointMemory;
 
     unsigned long numResets;
     DiGraph::size_type curVertexSize;
@@ -169,18 +494,73 @@ struct DynamicDiGraph::CheshireCat {
     bool graphChangedSinceLastReset;
 
     CheshireCat() : timeIndex(0U), opIndex(0U), doubleArcIsRemoval(false),
-        vertexToIdMapNextOpIndex(0ULL), numResets(0U),
+        arcIndexEnabled(false), lightweightConstruction(false),
+        denseIds(false), nextFreeId(0U), nameVertices(true),
+        netDeltas(false), numCanonicalDeltas(0U),
+        lastDeltaSize(0U), lastDeltaSizeIndex(NO_RECORD), lastDeltaSizeEnd(0U),
+        online(false), numDiscardedOps(0U), windowLength(0U), numExpiredArcs(0U),
+        temporalIndexValid(false), constructionStateStale(false),
+        collectingDelta(false), notificationsSuspended(false),
+        checkpointInterval(0U), checkpointMemoryBudget(0U), checkpointMemory(0U),
+        numResets(0U),
         curVertexSize(0ULL), curArcSize(0ULL), maxVertexSize(0ULL), maxArcSize(0ULL),
         graphChangedSinceLastReset(false) {
-        constructionArcMap.setDefaultValue(nullptr);
-        vertexToIdMap.setDefaultValue(0U);
+        constructionArcMap.setDefaultValue(NO_RECORD);
+        dynVertexRecords.setDefaultValue(NO_RECORD);
+        dynArcRecords.setDefaultValue(NO_RECORD);
         clear();
     }
     ~CheshireCat() {
+        deltaListeners.clear();
+        defragmentListeners.clear();
         clear();
     }
 
+    // Delta listeners do not observe dynGraph, so they are told before and after it is
+    // rebuilt by f() instead of being notified of the single changes, and so are the
+    // given further algorithms. A former vertex is remapped to the vertex of the same
+    // record, if it is present afterwards.
+    template<typename F>
+    void rebuildNotifying(std::vector<DynamicDiGraphAlgorithm*> listeners, const F &f) {
+        if (!notificationsSuspended) {
+            for (auto *algorithm : deltaListeners) {
+                if (std::find(listeners.begin(), listeners.end(), algorithm) == listeners.end()) {
+                    listeners.push_back(algorithm);
+                }
+            }
+        }
+        if (listeners.empty()) {
+            f();
+            return;
+        }
+        std::unordered_map<const Vertex*, DynamicDiGraph::size_type> formerRecords;
+        formerRecords.reserve(dynGraph.getSize());
+        dynGraph.mapVertices([this,&formerRecords](Vertex *v) {
+            formerRecords[v] = dynVertexRecords(v);
+        });
+
+        for (auto *algorithm : listeners) {
+            algorithm->beforeGraphRebuild();
+        }
+        bool suspended = notificationsSuspended;
+        notificationsSuspended = true;
+        f();
+        notificationsSuspended = suspended;
+
+        auto remap = [this,&formerRecords](const Vertex *v) -> Vertex* {
+            auto i = formerRecords.find(v);
+            return i == formerRecords.end() ? nullptr : vertexRecordVertices[i->second];
+        };
+        for (auto *algorithm : listeners) {
+            algorithm->afterGraphRebuild(remap);
+        }
+    }
+
     void reset() {
+        rebuildNotifying({}, [this]() { resetGraph(); });
+    }
+
+    void resetGraph() {
         timeIndex = 0U;
         opIndex = 0U;
         if (graphChangedSinceLastReset) {
@@ -190,29 +570,30 @@ struct DynamicDiGraph::CheshireCat {
         } else {
             dynGraph.clear();
         }
-        //vertexToIdMap.clear();
-        vertexToIdMap.resetAll(maxVertexSize);
-        vertexToIdMapNextOpIndex = 0ULL;
 
-        antedated.reset();
-        for (auto op : operations) {
-            op->reset();
-        }
+        std::fill(vertexRecordVertices.begin(), vertexRecordVertices.end(), nullptr);
+        std::fill(slotVertices.begin(), slotVertices.end(), nullptr);
+        std::fill(arcRecordArcs.begin(), arcRecordArcs.end(), nullptr);
+        expiryQueue.clear();
         numResets++;
 
         graphChangedSinceLastReset = false;
     }
 
     void init() {
-        if (!antedated.operations.empty()) {
-            antedated.apply(&dynGraph);
+        for (auto vr : antedated) {
+            applyVertexAddition(vr);
         }
     }
 
     void clear() {
         reset();
         vertices.clear();
+        denseIdMap = std::make_shared<DenseIdMap>();
+        slotIds.clear();
+        nextFreeId = 0U;
         constructionArcMap.resetAll(0);
+        arcIndex.clear();
         constructionGraph.clear();
         timestamps.clear();
         curVertexSize = 0ULL;
@@ -220,12 +601,41 @@ struct DynamicDiGraph::CheshireCat {
         maxVertexSize = 0ULL;
         maxArcSize = 0ULL;
 
+        clearCheckpoints();
+        numCanonicalDeltas = 0U;
+        lastDeltaSizeIndex = NO_RECORD;
+        netTransfers = std::make_shared<TransferMap>();
         antedated.clear();
-        for (auto op : operations) {
-            delete op;
-        }
-        operations.clear();
+        opCodes.clear();
+        opArgs.clear();
         offset.clear();
+        typeCountsBefore.clear();
+        typeCounts.fill(0U);
+
+        vertexRecordIds.clear();
+        vertexRecordVertices.clear();
+        slotVertices.clear();
+        vertexRecordConstructionVertices.clear();
+        arcRecordTails.clear();
+        arcRecordHeads.clear();
+        arcRecordArcs.clear();
+        arcRecordConstructionArcs.clear();
+        vertexRecordDegrees.clear();
+        vertexRecordIncidentArcs.clear();
+        arcRecordConstructed.clear();
+
+        numDiscardedOps = 0U;
+        arcRecordExpiry.clear();
+        arcRecordAdditionTimes.clear();
+        arcRecordConstructionExpired.clear();
+        constructionExpiryQueue.clear();
+        numExpiredArcs = 0U;
+        freeVertexRecords.clear();
+        freeArcRecords.clear();
+
+        clearTemporalIndex();
+        constructionStateStale = false;
+        mappedLog.reset();
     }
 
     void checkTimestamp(DynamicTime timestamp) {
@@ -233,6 +643,7 @@ struct DynamicDiGraph::CheshireCat {
             throw std::invalid_argument("Timestamps must be non-decreasing.");
         }
         extendTime(timestamp);
+        expireConstructedArcs(timestamp);
     }
 
     void extendTime(DynamicTime timestamp) {
@@ -240,101 +651,518 @@ struct DynamicDiGraph::CheshireCat {
             //PRINT_DEBUG( "Extending time from "
             //            << (timestamps.empty() ? 0U : timestamps.back()) << " to " << timestamp )
             timestamps.push_back(timestamp);
-            offset.push_back(operations.size());
+            temporalIndexValid = false;
+            offset.push_back(opCodes.size());
+            typeCountsBefore.push_back(typeCounts);
+        }
+    }
+
+    void appendOperation(Operation::Type type, DynamicDiGraph::size_type arg,
+                         std::uint8_t flags = 0U) {
+        opCodes.push_back(type | flags);
+        opArgs.push_back(arg);
+        temporalIndexValid = false;
+        if (numCanonicalDeltas == timestamps.size()) {
+            // the final delta has grown and has to be canonicalized again
+            numCanonicalDeltas--;
+        }
+        if (!(flags & Operation::IMPLICIT)) {
+            typeCounts[type]++;
+        }
+    }
+
+    DynamicDiGraph::size_type findSlot(VertexIdentifier vertexId) const {
+        if (!denseIds) {
+            return vertexId < vertices.size() ? vertexId : NO_RECORD;
+        }
+        auto i = denseIdMap->find(vertexId);
+        return i == denseIdMap->end() ? NO_RECORD : i->second;
+    }
+
+    DynamicDiGraph::size_type findOrCreateSlot(VertexIdentifier vertexId) {
+        if (vertexId >= nextFreeId) {
+            nextFreeId = vertexId + 1;
+        }
+        if (!denseIds) {
+            if (vertexId >= vertices.size()) {
+                vertices.resize(vertexId + 1, NO_RECORD);
+            }
+            return vertexId;
+        }
+        auto inserted = modifiable(denseIdMap).emplace(vertexId, vertices.size());
+        if (inserted.second) {
+            vertices.push_back(NO_RECORD);
+            slotIds.push_back(vertexId);
+        }
+        return inserted.first->second;
+    }
+
+    DynamicDiGraph::size_type recordOfId(VertexIdentifier vertexId) const {
+        auto slot = findSlot(vertexId);
+        return slot == NO_RECORD ? NO_RECORD : vertices[slot];
+    }
+
+    void setDenseIds(bool dense) {
+        if (dense == denseIds) {
+            return;
+        }
+        if (!vertexRecordIds.empty()) {
+            throw std::logic_error("Vertex id mode can only be changed while the graph is empty.");
+        }
+        vertices.clear();
+        denseIds = dense;
+    }
+
+    VertexIdentifier denseIdOf(VertexIdentifier vertexId) const {
+        auto slot = findSlot(vertexId);
+        if (slot == NO_RECORD) {
+            throw std::invalid_argument("Vertex ID does not exist.");
+        }
+        return slot;
+    }
+
+    VertexIdentifier originalIdOf(VertexIdentifier denseId) const {
+        if (denseId >= vertices.size()) {
+            throw std::invalid_argument("Dense vertex ID does not exist.");
+        }
+        return denseIds ? slotIds[denseId] : denseId;
+    }
+
+    DynamicDiGraph::size_type createVertexRecord(VertexIdentifier vertexId, DynamicDiGraph::size_type slot) {
+        DynamicDiGraph::size_type vr;
+        if (!freeVertexRecords.empty()) {
+            vr = freeVertexRecords.back();
+            freeVertexRecords.pop_back();
+            vertexRecordIds.set(vr, vertexId);
+        } else {
+            vr = vertexRecordIds.size();
+            vertexRecordIds.push_back(vertexId);
+            vertexRecordVertices.push_back(nullptr);
+            if (lightweightConstruction) {
+                vertexRecordDegrees.push_back(0U);
+                vertexRecordIncidentArcs.emplace_back();
+            } else {
+                vertexRecordConstructionVertices.push_back(nullptr);
+            }
+        }
+        constructVertex(vr);
+        vertices.set(slot, vr);
+        curVertexSize++;
+        return vr;
+    }
+
+    DynamicDiGraph::size_type createArcRecord(DynamicDiGraph::size_type tailRecord,
+                                              DynamicDiGraph::size_type headRecord) {
+        DynamicDiGraph::size_type ar;
+        if (!freeArcRecords.empty()) {
+            ar = freeArcRecords.back();
+            freeArcRecords.pop_back();
+            arcRecordTails.set(ar, tailRecord);
+            arcRecordHeads.set(ar, headRecord);
+            arcRecordAdditionTimes[ar] = timestamps.back();
+        } else {
+            ar = arcRecordTails.size();
+            arcRecordTails.push_back(tailRecord);
+            arcRecordHeads.push_back(headRecord);
+            arcRecordArcs.push_back(nullptr);
+            arcRecordAdditionTimes.push_back(timestamps.back());
+            arcRecordConstructionExpired.push_back(false);
+            if (lightweightConstruction) {
+                arcRecordConstructed.push_back(false);
+            } else {
+                arcRecordConstructionArcs.push_back(nullptr);
+            }
+        }
+        constructArc(ar);
+        if (windowLength > 0U) {
+            constructionExpiryQueue.emplace_back(timestamps.back() + windowLength, ar);
+        }
+        curArcSize++;
+        return ar;
+    }
+
+    void constructVertex(DynamicDiGraph::size_type vr) {
+        if (!lightweightConstruction) {
+            vertexRecordConstructionVertices[vr] = constructionGraph.addVertex();
+        }
+    }
+
+    void constructArc(DynamicDiGraph::size_type ar) {
+        auto tailRecord = arcRecordTails[ar];
+        auto headRecord = arcRecordHeads[ar];
+        if (lightweightConstruction) {
+            arcRecordConstructed[ar] = true;
+            vertexRecordDegrees[tailRecord]++;
+            vertexRecordDegrees[headRecord]++;
+            addIncidentArc(tailRecord, ar);
+            if (headRecord != tailRecord) {
+                addIncidentArc(headRecord, ar);
+            }
+        } else {
+            Arc *ca = constructionGraph.addArc(vertexRecordConstructionVertices[tailRecord],
+                    vertexRecordConstructionVertices[headRecord]);
+            arcRecordConstructionArcs[ar] = ca;
+            constructionArcMap[ca] = ar;
+        }
+        arcRecordConstructionExpired[ar] = false;
+        if (arcIndexEnabled) {
+            indexArc(ar);
+        }
+    }
+
+    bool isConstructed(DynamicDiGraph::size_type ar) const {
+        return lightweightConstruction ? arcRecordConstructed[ar]
+                                       : arcRecordConstructionArcs[ar] != nullptr;
+    }
+
+    bool hasExpired(DynamicDiGraph::size_type ar, DynamicTime now) const {
+        return windowLength > 0U && arcRecordAdditionTimes[ar] + windowLength <= now;
+    }
+
+    DynamicTime finalTime() const {
+        return timestamps.empty() ? 0U : timestamps.back();
+    }
+
+    void expireConstructedArcs(DynamicTime now) {
+        while (!constructionExpiryQueue.empty() && constructionExpiryQueue.front().first <= now) {
+            auto ar = constructionExpiryQueue.front().second;
+            constructionExpiryQueue.pop_front();
+            if (isConstructed(ar) && hasExpired(ar, now) && !arcRecordConstructionExpired[ar]) {
+                arcRecordConstructionExpired[ar] = true;
+                numExpiredArcs++;
+            }
+        }
+    }
+
+    // to be called whenever an arc leaves the construction state
+    void forgetConstructedArcExpiry(DynamicDiGraph::size_type ar) {
+        if (arcRecordConstructionExpired[ar]) {
+            arcRecordConstructionExpired[ar] = false;
+            numExpiredArcs--;
+        }
+    }
+
+    void resetConstructionExpiry() {
+        constructionExpiryQueue.clear();
+        arcRecordConstructionExpired.assign(arcRecordTails.size(), false);
+        numExpiredArcs = 0U;
+        if (windowLength == 0U) {
+            return;
+        }
+        std::vector<std::pair<DynamicTime, DynamicDiGraph::size_type>> expiries;
+        for (DynamicDiGraph::size_type ar = 0U; ar < arcRecordTails.size(); ar++) {
+            if (isConstructed(ar)) {
+                expiries.emplace_back(arcRecordAdditionTimes[ar] + windowLength, ar);
+            }
+        }
+        std::sort(expiries.begin(), expiries.end());
+        constructionExpiryQueue.assign(expiries.begin(), expiries.end());
+        expireConstructedArcs(finalTime());
+    }
+
+    void restoreConstructionState() {
+        if (!constructionStateStale) {
+            return;
+        }
+        constructionStateStale = false;
+
+        std::vector<bool> vertexPresent(vertexRecordIds.size(), false);
+        std::vector<bool> arcPresent(arcRecordTails.size(), false);
+        for (auto vr : antedated) {
+            vertexPresent[vr] = true;
+        }
+        arcRecordAdditionTimes.assign(arcRecordTails.size(), 0U);
+        arcRecordConstructionExpired.assign(arcRecordTails.size(), false);
+        DynamicDiGraph::size_type tIndex = 0U;
+        for (DynamicDiGraph::size_type i = 0U; i < opCodes.size(); i++) {
+            while (tIndex + 1U < offset.size() && i >= offset[tIndex + 1U]) {
+                tIndex++;
+            }
+            const auto r = opArgs[i];
+            switch (Operation::typeOf(opCodes[i])) {
+            case Operation::VERTEX_ADDITION:
+                vertexPresent[r] = true;
+                break;
+            case Operation::VERTEX_REMOVAL:
+                vertexPresent[r] = false;
+                break;
+            case Operation::ARC_ADDITION:
+                arcPresent[r] = true;
+                arcRecordAdditionTimes[r] = timestamps[tIndex];
+                break;
+            case Operation::ARC_REMOVAL:
+                arcPresent[r] = false;
+                break;
+            default:
+                break;
+            }
+        }
+
+        if (lightweightConstruction) {
+            vertexRecordDegrees.assign(vertexRecordIds.size(), 0U);
+            vertexRecordIncidentArcs.resize(vertexRecordIds.size());
+            arcRecordConstructed.assign(arcRecordTails.size(), false);
+        } else {
+            vertexRecordConstructionVertices.assign(vertexRecordIds.size(), nullptr);
+            arcRecordConstructionArcs.assign(arcRecordTails.size(), nullptr);
+        }
+        for (DynamicDiGraph::size_type vr = 0U; vr < vertexPresent.size(); vr++) {
+            if (vertexPresent[vr]) {
+                constructVertex(vr);
+            }
+        }
+        for (DynamicDiGraph::size_type ar = 0U; ar < arcPresent.size(); ar++) {
+            if (arcPresent[ar]) {
+                constructArc(ar);
+            }
+        }
+        resetConstructionExpiry();
+    }
+
+    void addIncidentArc(DynamicDiGraph::size_type vr, DynamicDiGraph::size_type ar) {
+        auto &incident = vertexRecordIncidentArcs[vr];
+        // removed arcs are purged lazily
+        if (incident.size() >= 2U * vertexRecordDegrees[vr] + 8U) {
+            incident.erase(std::remove_if(incident.begin(), incident.end(),
+                                          [this,vr](DynamicDiGraph::size_type a) {
+                return !isConstructedIncident(a, vr);
+            }), incident.end());
+        }
+        incident.push_back(ar);
+    }
+
+    // arc records may have been recycled since they were added to an incidence list
+    bool isConstructedIncident(DynamicDiGraph::size_type ar, DynamicDiGraph::size_type vr) const {
+        return arcRecordConstructed[ar] && (arcRecordTails[ar] == vr || arcRecordHeads[ar] == vr);
+    }
+
+    void setLightweightConstruction(bool lightweight) {
+        if (lightweight == lightweightConstruction) {
+            return;
+        }
+        if (!vertexRecordIds.empty()) {
+            throw std::logic_error("Construction mode can only be changed while the graph is empty.");
+        }
+        lightweightConstruction = lightweight;
+        if (lightweight) {
+            setArcIndexEnabled(true);
+        }
+    }
+
+    ArcKey keyOfArcRecord(DynamicDiGraph::size_type ar) const {
+        return ArcKey(vertexRecordIds[arcRecordTails[ar]], vertexRecordIds[arcRecordHeads[ar]]);
+    }
+
+    void indexArc(DynamicDiGraph::size_type ar) {
+        arcIndex.emplace(keyOfArcRecord(ar), ar);
+    }
+
+    void unindexArc(DynamicDiGraph::size_type ar) {
+        auto range = arcIndex.equal_range(keyOfArcRecord(ar));
+        for (auto i = range.first; i != range.second; i++) {
+            if (i->second == ar) {
+                arcIndex.erase(i);
+                return;
+            }
+        }
+    }
+
+    void setArcIndexEnabled(bool enable) {
+        if (enable == arcIndexEnabled) {
+            return;
+        }
+        if (!enable && lightweightConstruction) {
+            throw std::logic_error("Lightweight construction requires the arc index.");
+        }
+        arcIndex.clear();
+        arcIndexEnabled = enable;
+        if (enable && constructionStateStale) {
+            restoreConstructionState();
+        } else if (enable) {
+            arcIndex.reserve(curArcSize);
+            constructionGraph.mapArcs([this](Arc *ca) {
+                indexArc(constructionArcMap(ca));
+            });
         }
     }
 
     VertexIdentifier addVertex(DynamicTime timestamp, bool atEnd, VertexIdentifier vertexId = 0U,
                                bool okIfExists = false) {
+        restoreConstructionState();
         checkTimestamp(timestamp);
 
         if (atEnd) {
-            vertexId = vertices.size();
+            vertexId = nextFreeId;
         }
-        if (vertexId >= vertices.size()) {
-            vertices.resize(vertexId + 1, nullptr);
-        } else if (!okIfExists && vertexId < vertices.size() && vertices.at(vertexId) != nullptr) {
+        auto slot = findOrCreateSlot(vertexId);
+        if (!okIfExists && vertices[slot] != NO_RECORD) {
             throw std::invalid_argument("A vertex with this id exists already.");
         }
 
-        Vertex *cv = constructionGraph.addVertex();
-        AddVertexOperation *avo = new AddVertexOperation(cv, vertexId);
-        operations.push_back(avo);
-        vertices[vertexId] = avo;
+        auto vr = createVertexRecord(vertexId, slot);
+        appendOperation(Operation::VERTEX_ADDITION, vr);
 
-        curVertexSize++;
         if (curVertexSize > maxVertexSize) {
             maxVertexSize = curVertexSize;
         }
 
         graphChangedSinceLastReset = true;
+        applyOnline();
 
         return vertexId;
     }
 
     void removeVertex(VertexIdentifier vertexId, DynamicTime timestamp) {
-        if (vertexId >= vertices.size() || vertices.at(vertexId) == nullptr) {
+        restoreConstructionState();
+        auto slot = findSlot(vertexId);
+        if (slot == NO_RECORD || vertices[slot] == NO_RECORD) {
             throw std::invalid_argument("Vertex ID does not exist.");
         }
 
         checkTimestamp(timestamp);
 
-        AddVertexOperation *avo = vertices[vertexId];
+        auto vr = vertices[slot];
+        removeIncidentArcs(vr);
+        removeConstructedVertex(vr);
+        appendOperation(Operation::VERTEX_REMOVAL, vr);
+        vertices.set(slot, NO_RECORD);
+
+        curVertexSize--;
+
+        graphChangedSinceLastReset = true;
+        applyOnline();
+    }
+
+    void removeIncidentArcs(DynamicDiGraph::size_type vr) {
+        auto removeImplicitly = [this](DynamicDiGraph::size_type ar) {
+            if (arcIndexEnabled) {
+                unindexArc(ar);
+            }
+            forgetConstructedArcExpiry(ar);
+            appendOperation(Operation::ARC_REMOVAL, ar, Operation::IMPLICIT | Operation::GROUPED);
+            curArcSize--;
+        };
+
+        if (lightweightConstruction) {
+            for (auto ar : vertexRecordIncidentArcs[vr]) {
+                if (isConstructedIncident(ar, vr)) {
+                    arcRecordConstructed[ar] = false;
+                    vertexRecordDegrees[arcRecordTails[ar]]--;
+                    vertexRecordDegrees[arcRecordHeads[ar]]--;
+                    removeImplicitly(ar);
+                }
+            }
+            return;
+        }
 
-        auto removeIncidentArcs = [&](Arc *a) {
+        Vertex *cv = vertexRecordConstructionVertices[vr];
+        auto removeArcOfVertex = [&](Arc *a) {
+            auto ar = constructionArcMap(a);
+            if (ar == NO_RECORD) {
+                // loops are visited twice
+                return;
+            }
+            arcRecordConstructionArcs[ar] = nullptr;
             constructionArcMap.resetToDefault(a);
+            removeImplicitly(ar);
         };
+        constructionGraph.mapOutgoingArcs(cv, removeArcOfVertex);
+        constructionGraph.mapIncomingArcs(cv, removeArcOfVertex);
+    }
 
-        constructionGraph.mapOutgoingArcs(avo->constructionVertex, removeIncidentArcs);
-        constructionGraph.mapIncomingArcs(avo->constructionVertex, removeIncidentArcs);
+    void removeConstructedVertex(DynamicDiGraph::size_type vr) {
+        if (lightweightConstruction) {
+            assert(vertexRecordDegrees[vr] == 0U);
+            std::vector<DynamicDiGraph::size_type>().swap(vertexRecordIncidentArcs[vr]);
+        } else {
+            constructionGraph.removeVertex(vertexRecordConstructionVertices[vr]);
+            vertexRecordConstructionVertices[vr] = nullptr;
+        }
+    }
 
-        constructionGraph.removeVertex(avo->constructionVertex);
-        RemoveVertexOperation *rvo = new RemoveVertexOperation(avo);
-        operations.push_back(rvo);
-        vertices[vertexId] = nullptr;
+    void removeConstructedArc(DynamicDiGraph::size_type ar) {
+        if (arcIndexEnabled) {
+            unindexArc(ar);
+        }
+        forgetConstructedArcExpiry(ar);
+        if (lightweightConstruction) {
+            arcRecordConstructed[ar] = false;
+            vertexRecordDegrees[arcRecordTails[ar]]--;
+            vertexRecordDegrees[arcRecordHeads[ar]]--;
+        } else {
+            Arc *ca = arcRecordConstructionArcs[ar];
+            assert(constructionArcMap(ca) == ar);
+            constructionGraph.removeArc(ca);
+            constructionArcMap.resetToDefault(ca);
+            arcRecordConstructionArcs[ar] = nullptr;
+        }
+    }
 
-        curVertexSize--;
+    bool isIsolated(DynamicDiGraph::size_type vr) const {
+        if (lightweightConstruction) {
+            return vertexRecordDegrees[vr] == 0U;
+        }
+        return dynamic_cast<IncidenceListVertex*>(vertexRecordConstructionVertices[vr])->isIsolated();
+    }
 
-        graphChangedSinceLastReset = true;
+    // whether all constructed arcs at a vertex record have expired by now
+    bool isIsolatedAt(DynamicDiGraph::size_type vr, DynamicTime now) {
+        if (isIsolated(vr)) {
+            return true;
+        } else if (windowLength == 0U) {
+            return false;
+        }
+        bool live = false;
+        if (lightweightConstruction) {
+            for (auto ar : vertexRecordIncidentArcs[vr]) {
+                if (isConstructedIncident(ar, vr) && !hasExpired(ar, now)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        Vertex *cv = vertexRecordConstructionVertices[vr];
+        auto checkArc = [&](Arc *a) {
+            live = !hasExpired(constructionArcMap(a), now);
+        };
+        auto isLive = [&](const Arc*) { return live; };
+        constructionGraph.mapOutgoingArcsUntil(cv, checkArc, isLive);
+        constructionGraph.mapIncomingArcsUntil(cv, checkArc, isLive);
+        return !live;
     }
 
     void addArc(VertexIdentifier tailId, VertexIdentifier headId, DynamicTime timestamp, bool antedateVertexAddition)
     {
+        restoreConstructionState();
         checkTimestamp(timestamp);
 
-        auto maxId = tailId > headId ? tailId : headId;
-        if (maxId >= vertices.size()) {
-            vertices.resize(maxId + 1, nullptr);
-        }
-
-        AddVertexOperation *avoTail = vertices.at(tailId);;
-        AddVertexOperation *avoHead = vertices.at(headId);
+        auto tailSlot = findOrCreateSlot(tailId);
+        auto headSlot = findOrCreateSlot(headId);
+        auto vrTail = vertices[tailSlot];
+        auto vrHead = vertices[headSlot];
 
-        OperationSet *os = nullptr;
-        if (avoTail == nullptr || avoHead == nullptr) {
-            if (antedateVertexAddition && timeIndex == 0U) {
-                os = &antedated;
-            } else {
-                os = new OperationSet;
-            }
+        if (vrTail == NO_RECORD || vrHead == NO_RECORD) {
+            bool antedate = antedateVertexAddition && timeIndex == 0U;
 
-            if (avoTail == nullptr) {
-                Vertex *cv = constructionGraph.addVertex();
-                avoTail = new AddVertexOperation(cv, tailId);
-                os->operations.push_back(avoTail);
-                vertices[tailId] = avoTail;
-                curVertexSize++;
+            if (vrTail == NO_RECORD) {
+                vrTail = createVertexRecord(tailId, tailSlot);
+                if (antedate) {
+                    antedated.push_back(vrTail);
+                } else {
+                    appendOperation(Operation::VERTEX_ADDITION, vrTail, Operation::GROUPED);
+                }
 
                 if (tailId == headId) {
-                    avoHead = avoTail;
+                    vrHead = vrTail;
                 }
             }
-            if (avoHead == nullptr) {
-                Vertex *cv = constructionGraph.addVertex();
-                avoHead = new AddVertexOperation(cv, headId);
-                os->operations.push_back(avoHead);
-                vertices[headId] = avoHead;
-                curVertexSize++;
+            if (vrHead == NO_RECORD) {
+                vrHead = createVertexRecord(headId, headSlot);
+                if (antedate) {
+                    antedated.push_back(vrHead);
+                } else {
+                    appendOperation(Operation::VERTEX_ADDITION, vrHead, Operation::GROUPED);
+                }
             }
 
             if (curVertexSize > maxVertexSize) {
@@ -342,124 +1170,496 @@ struct DynamicDiGraph::CheshireCat {
             }
         }
 
+        auto ar = createArcRecord(vrTail, vrHead);
+        appendOperation(Operation::ARC_ADDITION, ar);
 
-        Arc *ca = constructionGraph.addArc(avoTail->constructionVertex, avoHead->constructionVertex);
-        AddArcOperation *aao = new AddArcOperation(avoTail, avoHead, ca);
-        if (os && os != &antedated) {
-            os->operations.push_back(aao);
-            operations.push_back(os);
-        } else {
-            operations.push_back(aao);
-        }
-        constructionArcMap[ca] = aao;
-
-        curArcSize++;
-        if (curArcSize > maxArcSize) {
-            maxArcSize = curArcSize;
+        if (curArcSize - numExpiredArcs > maxArcSize) {
+            maxArcSize = curArcSize - numExpiredArcs;
         }
 
         graphChangedSinceLastReset = true;
+        applyOnline();
     }
 
     void noop(DynamicTime timestamp) {
         checkTimestamp(timestamp);
-        NoOperation *nop = new NoOperation;
-        operations.push_back(nop);
+        appendOperation(Operation::NONE, 0U);
+        applyOnline();
+    }
+
+    void setOnline(bool on) {
+        if (on == online) {
+            return;
+        }
+        if (!vertexRecordIds.empty() || !opCodes.empty()) {
+            throw std::logic_error("Online mode can only be changed while the graph is empty.");
+        }
+        online = on;
     }
 
-    Arc *findArc(VertexIdentifier tailId, VertexIdentifier headId) {
-        if (tailId >= vertices.size() || headId >= vertices.size()) {
-            return nullptr;
+    void applyOnline() {
+        if (!online) {
+            return;
         }
-        auto avoTail = vertices[tailId];
-        auto avoHead = vertices[headId];
-        if (avoTail == nullptr || avoHead == nullptr) {
-            return nullptr;
+        while (nextOp()) { }
+        discardAppliedOperations();
+    }
+
+    // Drops all applied operations and all deltas but the current one.
+    // Afterwards, the replay graph cannot be reset to earlier times.
+    void discardAppliedOperations() {
+        for (DynamicDiGraph::size_type i = 0U; i < opIndex; i++) {
+            switch (Operation::typeOf(opCodes[i])) {
+            case Operation::VERTEX_REMOVAL:
+                freeVertexRecords.push_back(opArgs[i]);
+                break;
+            case Operation::ARC_REMOVAL:
+                freeArcRecords.push_back(opArgs[i]);
+                break;
+            default:
+                break;
+            }
         }
-        Vertex *ct = avoTail->constructionVertex;
-        Vertex *ch = avoHead->constructionVertex;
-        Arc *ca = nullptr;
+        numDiscardedOps += opIndex;
+        opCodes.erase(opCodes.begin(), opCodes.begin() + opIndex);
+        opArgs.erase(opArgs.begin(), opArgs.begin() + opIndex);
+        antedated.clear();
+        netTransfers = std::make_shared<TransferMap>();
+        numCanonicalDeltas = 0U;
+        lastDeltaSizeIndex = NO_RECORD;
+        clearCheckpoints();
+
+        if (timestamps.size() > 1U) {
+            timestamps.erase(timestamps.begin(), timestamps.end() - 1);
+            typeCountsBefore.erase(typeCountsBefore.begin(), typeCountsBefore.end() - 1);
+        }
+        offset.clear();
+        offset.push_back(0U);
+        timeIndex = 0U;
+        opIndex = 0U;
+    }
+
+    bool atStart() const {
+        return opIndex == 0U && numDiscardedOps == 0U;
+    }
+
+    // With a sliding window, prefers the oldest arc that has not expired by now.
+    DynamicDiGraph::size_type findArc(VertexIdentifier tailId, VertexIdentifier headId,
+                                      DynamicTime now) {
+        restoreConstructionState();
+        auto found = NO_RECORD;
+        auto consider = [&](DynamicDiGraph::size_type ar) {
+            if (found == NO_RECORD || (hasExpired(found, now) && !hasExpired(ar, now))
+                    || (!hasExpired(ar, now)
+                        && arcRecordAdditionTimes[ar] < arcRecordAdditionTimes[found])) {
+                found = ar;
+            }
+        };
+        auto done = [&]() {
+            return windowLength == 0U && found != NO_RECORD;
+        };
+        if (arcIndexEnabled) {
+            auto range = arcIndex.equal_range(ArcKey(tailId, headId));
+            for (auto i = range.first; i != range.second && !done(); i++) {
+                consider(i->second);
+            }
+            return found;
+        }
+        auto vrTail = recordOfId(tailId);
+        auto vrHead = recordOfId(headId);
+        if (vrTail == NO_RECORD || vrHead == NO_RECORD) {
+            return NO_RECORD;
+        }
+        Vertex *ct = vertexRecordConstructionVertices[vrTail];
+        Vertex *ch = vertexRecordConstructionVertices[vrHead];
         constructionGraph.mapOutgoingArcsUntil(ct, [&](Arc *a) {
             if (a->getHead() == ch) {
-                ca = a;
+                consider(constructionArcMap(a));
             }
-        }, [&](const Arc*) { return ca != nullptr; });
+        }, [&](const Arc*) { return done(); });
 
-        return ca;
+        return found;
+    }
+
+    bool hasArc(VertexIdentifier tailId, VertexIdentifier headId, DynamicTime now) {
+        auto ar = findArc(tailId, headId, now);
+        return ar != NO_RECORD && !hasExpired(ar, now);
     }
 
     void removeArc(VertexIdentifier tailId, VertexIdentifier headId, DynamicTime timestamp, bool removeIsolatedEnds) {
-        Arc *ca = findArc(tailId, headId);
-        if (!ca) {
+        // an expired arc is only removed if there is no other one, its removal is skipped on replay
+        auto ar = findArc(tailId, headId, timestamp);
+        if (ar == NO_RECORD) {
             throw std::invalid_argument("Arc does not exist.");
         }
 
         checkTimestamp(timestamp);
 
-        AddArcOperation *aao = constructionArcMap[ca];
-        assert(ca == aao->constructionArc);
-        RemoveArcOperation *rao = new RemoveArcOperation(aao);
-        constructionGraph.removeArc(ca);
-        constructionArcMap.resetToDefault(ca);
+        removeConstructedArc(ar);
 
         if (removeIsolatedEnds) {
-            AddVertexOperation *avoTail = vertices[tailId];
-            AddVertexOperation *avoHead = vertices[headId];
-            IncidenceListVertex *tail = dynamic_cast<IncidenceListVertex*>(avoTail->constructionVertex);
-            IncidenceListVertex *head = dynamic_cast<IncidenceListVertex*>(avoHead->constructionVertex);
-            if (tail->isIsolated() || head->isIsolated()) {
-                OperationSet *op = new OperationSet;
-                op->operations.push_back(rao);
-                if (tail->isIsolated()) {
-                    constructionGraph.removeVertex(avoTail->constructionVertex);
-                    RemoveVertexOperation *rvo = new RemoveVertexOperation(avoTail);
-                    op->operations.push_back(rvo);
-                    vertices[tailId] = nullptr;
-                    curVertexSize--;
-                }
-                if (tailId != headId && head->isIsolated()) {
-                    constructionGraph.removeVertex(avoHead->constructionVertex);
-                    RemoveVertexOperation *rvo = new RemoveVertexOperation(avoHead);
-                    op->operations.push_back(rvo);
-                    vertices[headId] = nullptr;
-                    curVertexSize--;
-                }
-                operations.push_back(op);
-            } else {
-                operations.push_back(rao);
+            auto vrTail = arcRecordTails[ar];
+            auto vrHead = arcRecordHeads[ar];
+            bool removeTail = isIsolatedAt(vrTail, timestamp);
+            bool removeHead = tailId != headId && isIsolatedAt(vrHead, timestamp);
+            appendOperation(Operation::ARC_REMOVAL, ar,
+                            removeTail || removeHead ? Operation::GROUPED : 0U);
+            if (removeTail) {
+                // expired arcs are removed along with their ends
+                removeIncidentArcs(vrTail);
+                removeConstructedVertex(vrTail);
+                appendOperation(Operation::VERTEX_REMOVAL, vrTail,
+                                removeHead ? Operation::GROUPED : 0U);
+                vertices.set(findSlot(tailId), NO_RECORD);
+                curVertexSize--;
+            }
+            if (removeHead) {
+                removeIncidentArcs(vrHead);
+                removeConstructedVertex(vrHead);
+                appendOperation(Operation::VERTEX_REMOVAL, vrHead);
+                vertices.set(findSlot(headId), NO_RECORD);
+                curVertexSize--;
             }
         } else {
-            operations.push_back(rao);
+            appendOperation(Operation::ARC_REMOVAL, ar);
         }
         curArcSize--;
 
         graphChangedSinceLastReset = true;
+        applyOnline();
     }
 
     void compact(DynamicDiGraph::size_type num) {
-        std::vector<Operation*> ops;
+        auto first = opCodes.size();
         for (auto i = 0U; i < num; i++) {
-            auto *last = operations.back();
-            operations.pop_back();
-            auto nestedOs = dynamic_cast<OperationSet*>(last);
-            if (nestedOs) {
-                while (!nestedOs->operations.empty()) {
-                    ops.push_back(nestedOs->operations.back());
-                    nestedOs->operations.pop_back();
-                }
-                delete nestedOs;
+            if (first <= opIndex) {
+                throw std::invalid_argument("Cannot compact already executed operations.");
+            }
+            first = findStartOfOperation(first - 1);
+        }
+        if (first < opIndex) {
+            throw std::invalid_argument("Cannot compact already executed operations.");
+        }
+        std::uint8_t *codes = opCodes.modifiableData();
+        for (auto i = first; i + 1 < opCodes.size(); i++) {
+            codes[i] |= Operation::GROUPED;
+        }
+        lastDeltaSizeIndex = NO_RECORD;
+    }
+
+    DynamicDiGraph::size_type findStartOfOperation(DynamicDiGraph::size_type i) const {
+        while (i > 0U && Operation::isGrouped(opCodes[i - 1])) {
+            i--;
+        }
+        return i;
+    }
+
+    DynamicDiGraph::size_type countLogicalOperations(DynamicDiGraph::size_type from,
+                                                     DynamicDiGraph::size_type until) const {
+        DynamicDiGraph::size_type num = 0U;
+        for (auto i = from; i < until; i++) {
+            if (!Operation::isGrouped(opCodes[i])) {
+                num++;
+            }
+        }
+        return num;
+    }
+
+    bool notifyDeltaListeners() const {
+        return !deltaListeners.empty() && !notificationsSuspended;
+    }
+
+    // Whether the next delta can be collected and passed on at once; otherwise, listeners
+    // relying on sequential changes would see additions before being notified of them.
+    bool collectDelta() const {
+        return notifyDeltaListeners()
+                && std::all_of(deltaListeners.begin(), deltaListeners.end(),
+                               [](const DynamicDiGraphAlgorithm *algorithm) {
+            return !algorithm->doesAutoUpdate() || algorithm->doesReceiveDeltasAtOnce();
+        });
+    }
+
+    template<typename T>
+    void notify(void (DynamicDiGraphAlgorithm::*onChange)(T*), T *t) {
+        for (auto *algorithm : deltaListeners) {
+            if (algorithm->doesAutoUpdate()) {
+                (algorithm->*onChange)(t);
+            }
+        }
+    }
+
+    void setSlotVertex(DynamicDiGraph::size_type vr, Vertex *v) {
+        auto slot = findSlot(vertexRecordIds[vr]);
+        if (slot >= slotVertices.size()) {
+            slotVertices.resize(slot + 1U, nullptr);
+        }
+        slotVertices[slot] = v;
+    }
+
+    void applyVertexAddition(DynamicDiGraph::size_type vr) {
+        Vertex *v = dynGraph.addVertex();
+        if (nameVertices) {
+            v->setName(std::to_string(vertexRecordIds[vr]));
+        }
+        vertexRecordVertices[vr] = v;
+        setSlotVertex(vr, v);
+        dynVertexRecords[v] = vr;
+        if (notifyDeltaListeners()) {
+            if (collectingDelta) {
+                delta.addedVertices.push_back(v);
+            } else {
+                notify(&DynamicDiGraphAlgorithm::handleVertexAdd, v);
+            }
+        }
+    }
+
+    void applyVertexRemoval(DynamicDiGraph::size_type vr) {
+        Vertex *v = vertexRecordVertices[vr];
+        vertexRecordVertices[vr] = nullptr;
+        setSlotVertex(vr, nullptr);
+        if (notifyDeltaListeners()) {
+            if (collectingDelta) {
+                delta.removedVertices.push_back(v);
+                return;
+            }
+            notify(&DynamicDiGraphAlgorithm::handleVertexRemove, v);
+        }
+        dynGraph.removeVertex(v);
+    }
+
+    void applyArcAddition(DynamicDiGraph::size_type ar) {
+        Arc *a = dynGraph.addArc(vertexRecordVertices[arcRecordTails[ar]],
+                vertexRecordVertices[arcRecordHeads[ar]]);
+        arcRecordArcs[ar] = a;
+        dynArcRecords[a] = ar;
+        if (notifyDeltaListeners()) {
+            if (collectingDelta) {
+                delta.addedArcs.push_back(a);
+            } else {
+                notify(&DynamicDiGraphAlgorithm::handleArcAdd, a);
+            }
+        }
+    }
+
+    void applyArcRemoval(DynamicDiGraph::size_type ar) {
+        Arc *a = arcRecordArcs[ar];
+        arcRecordArcs[ar] = nullptr;
+        if (notifyDeltaListeners()) {
+            if (collectingDelta) {
+                delta.removedArcs.push_back(a);
+                return;
+            }
+            notify(&DynamicDiGraphAlgorithm::handleArcRemove, a);
+        }
+        dynGraph.removeArc(a);
+    }
+
+    // arc removed together with its end vertex
+    void applyImplicitArcRemoval(DynamicDiGraph::size_type ar) {
+        Arc *a = arcRecordArcs[ar];
+        if (a && notifyDeltaListeners()) {
+            if (collectingDelta) {
+                // the delta's removals are carried out in order
+                delta.removedArcs.push_back(a);
             } else {
-                ops.push_back(last);
+                notify(&DynamicDiGraphAlgorithm::handleArcRemove, a);
+            }
+        }
+        arcRecordArcs[ar] = nullptr;
+    }
+
+    void deliverDelta() {
+        for (auto *algorithm : deltaListeners) {
+            if (algorithm->doesAutoUpdate()) {
+                algorithm->handleDelta(delta.addedArcs, delta.removedArcs,
+                                       delta.addedVertices, delta.removedVertices);
+            }
+        }
+        for (auto *a : delta.removedArcs) {
+            dynGraph.removeArc(a);
+        }
+        for (auto *v : delta.removedVertices) {
+            dynGraph.removeVertex(v);
+        }
+        delta.addedArcs.clear();
+        delta.removedArcs.clear();
+        delta.addedVertices.clear();
+        delta.removedVertices.clear();
+    }
+
+    void transferArc(DynamicDiGraph::size_type arFrom, DynamicDiGraph::size_type arTo) {
+        Arc *a = arcRecordArcs[arFrom];
+        arcRecordArcs[arFrom] = nullptr;
+        arcRecordArcs[arTo] = a;
+        dynArcRecords[a] = arTo;
+    }
+
+    bool skipCancelled(DynamicDiGraph::size_type i, bool undo) {
+        if (!netDeltas || !Operation::isCancelled(opCodes[i])) {
+            return false;
+        }
+        if (Operation::typeOf(opCodes[i]) == Operation::ARC_ADDITION) {
+            auto t = netTransfers->find(i);
+            if (t != netTransfers->end()) {
+                auto arRemoved = opArgs[t->second];
+                if (undo) {
+                    transferArc(opArgs[i], arRemoved);
+                } else {
+                    transferArc(arRemoved, opArgs[i]);
+                    scheduleExpiry(opArgs[i]);
+                }
+            }
+        }
+        return true;
+    }
+
+    void applyOperation(DynamicDiGraph::size_type i) {
+        if (skipCancelled(i, false)) {
+            return;
+        }
+        const auto arg = opArgs[i];
+        const auto code = opCodes[i];
+        switch (Operation::typeOf(code)) {
+        case Operation::VERTEX_ADDITION:
+            applyVertexAddition(arg);
+            break;
+        case Operation::VERTEX_REMOVAL:
+            applyVertexRemoval(arg);
+            break;
+        case Operation::ARC_ADDITION:
+            applyArcAddition(arg);
+            scheduleExpiry(arg);
+            break;
+        case Operation::ARC_REMOVAL:
+            if (Operation::isImplicit(code)) {
+                applyImplicitArcRemoval(arg);
+            } else if (windowLength == 0U || arcRecordArcs[arg]) {
+                applyArcRemoval(arg);
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    void undoOperation(DynamicDiGraph::size_type i) {
+        if (skipCancelled(i, true)) {
+            return;
+        }
+        const auto arg = opArgs[i];
+        switch (Operation::typeOf(opCodes[i])) {
+        case Operation::VERTEX_ADDITION:
+            applyVertexRemoval(arg);
+            break;
+        case Operation::VERTEX_REMOVAL:
+            applyVertexAddition(arg);
+            break;
+        case Operation::ARC_ADDITION:
+            applyArcRemoval(arg);
+            break;
+        case Operation::ARC_REMOVAL:
+            applyArcAddition(arg);
+            break;
+        default:
+            break;
+        }
+    }
+
+    void undoInit() {
+        for (auto i = antedated.rbegin(); i != antedated.rend(); i++) {
+            applyVertexRemoval(*i);
+        }
+    }
+
+    void undoUntil(DynamicDiGraph::size_type minOp) {
+        PRINT_DEBUG( "Undoing operations #op" << minOp << " - #op" << opIndex)
+        while (opIndex > minOp) {
+            opIndex--;
+            undoOperation(opIndex);
+        }
+        if (opIndex == 0U) {
+            undoInit();
+        }
+    }
+
+    void scheduleExpiry(DynamicDiGraph::size_type ar) {
+        if (windowLength == 0U) {
+            return;
+        }
+        if (arcRecordExpiry.size() <= ar) {
+            arcRecordExpiry.resize(arcRecordTails.size());
+        }
+        arcRecordExpiry[ar] = timestamps[timeIndex] + windowLength;
+        expiryQueue.emplace_back(arcRecordExpiry[ar], ar);
+    }
+
+    void expireArcs(DynamicTime now) {
+        while (!expiryQueue.empty() && expiryQueue.front().first <= now) {
+            auto expiry = expiryQueue.front().first;
+            auto ar = expiryQueue.front().second;
+            expiryQueue.pop_front();
+            if (arcRecordArcs[ar] && arcRecordExpiry[ar] == expiry) {
+                PRINT_DEBUG("Arc record " << ar << " expired at " << now << ".")
+                applyArcRemoval(ar);
             }
         }
-        std::reverse(std::begin(ops), std::end(ops));
-        auto *os = new OperationSet;
-        os->operations = std::move(ops);
-        operations.push_back(os);
+    }
+
+    void setWindowLength(DynamicTime length) {
+        if (length == windowLength) {
+            return;
+        }
+        // the current state and checkpoints may contain arcs that should have expired
+        reset();
+        clearCheckpoints();
+        windowLength = length;
+        temporalIndexValid = false;
+        if (!constructionStateStale) {
+            resetConstructionExpiry();
+        }
+    }
+
+    // Expirations are not logged, so moving backward with a sliding window replays from the start.
+    void replayFromStart(DynamicDiGraph::size_type target) {
+        reset();
+        while (opIndex < target && nextOp()) { }
+    }
+
+    bool previousOp() {
+        if (opIndex == 0U) {
+            return false;
+        }
+        if (windowLength > 0U) {
+            replayFromStart(findStartOfOperation(opIndex - 1));
+            return true;
+        }
+        undoUntil(findStartOfOperation(opIndex - 1));
+        while (timeIndex > 0U && offset[timeIndex] >= opIndex) {
+            timeIndex--;
+        }
+        return true;
+    }
+
+    bool previousDelta() {
+        if (opIndex == 0U) {
+            return false;
+        }
+        Tracer::Scope trace("undoDelta", "graph");
+        trace.arg("time", timestamps[timeIndex]);
+        trace.arg("operations", opIndex - offset[timeIndex]);
+        if (windowLength > 0U) {
+            replayFromStart(offset[timeIndex]);
+            return true;
+        }
+        undoUntil(offset[timeIndex]);
+        if (timeIndex > 0U) {
+            timeIndex--;
+        }
+        return true;
     }
 
     bool advance(bool sameTime = false) {
-        if (opIndex >= operations.size()) {
+        if (opIndex >= opCodes.size()) {
             PRINT_DEBUG("Cannot advance further.")
             return false;
         }
@@ -475,33 +1675,426 @@ struct DynamicDiGraph::CheshireCat {
             init();
         }
 
+        if (windowLength > 0U && opIndex == offset[timeIndex]) {
+            // expirations are applied before the delta's own operations
+            expireArcs(timestamps[timeIndex]);
+        }
+
+        if (netDeltas && opIndex == offset[timeIndex] && timeIndex >= numCanonicalDeltas) {
+            canonicalizeDelta(timeIndex);
+            numCanonicalDeltas = timeIndex + 1U;
+        }
+
         return true;
     }
 
+    bool betweenDeltas() const {
+        return opIndex == 0U || opIndex == endOfDelta(timeIndex);
+    }
+
+    // Marks pairs of operations in a delta that cancel each other out:
+    // additions of vertices and arcs that are removed again, and removals of arcs that are
+    // re-added between the same vertices. In the latter case, the re-added arc record takes over
+    // the existing arc, so that the state after the delta is the same as with exact replay.
+    void canonicalizeDelta(DynamicDiGraph::size_type tIndex) {
+        const auto from = offset[tIndex];
+        const auto until = endOfDelta(tIndex);
+        std::uint8_t *codes = opCodes.modifiableData();
+        auto &transfers = modifiable(netTransfers);
+        for (auto i = from; i < until; i++) {
+            if (Operation::isCancelled(codes[i])
+                    && Operation::typeOf(codes[i]) == Operation::ARC_ADDITION) {
+                transfers.erase(i);
+            }
+            codes[i] &= ~Operation::CANCELLED;
+        }
+
+        std::unordered_map<DynamicDiGraph::size_type, DynamicDiGraph::size_type> vertexAddedAt;
+        std::unordered_map<DynamicDiGraph::size_type, DynamicDiGraph::size_type> arcAddedAt;
+        std::unordered_map<ArcKey, std::vector<DynamicDiGraph::size_type>, ArcKeyHash> arcRemovedAt;
+        auto cancel = [codes](DynamicDiGraph::size_type i) {
+            codes[i] |= Operation::CANCELLED;
+        };
+
+        for (auto i = from; i < until; i++) {
+            const auto r = opArgs[i];
+            switch (Operation::typeOf(codes[i])) {
+            case Operation::VERTEX_ADDITION:
+                vertexAddedAt[r] = i;
+                break;
+            case Operation::VERTEX_REMOVAL: {
+                // all incident arcs have been added within this delta and are cancelled already
+                auto added = vertexAddedAt.find(r);
+                if (added != vertexAddedAt.end()) {
+                    cancel(added->second);
+                    cancel(i);
+                    vertexAddedAt.erase(added);
+                }
+                break;
+            }
+            case Operation::ARC_ADDITION: {
+                auto removed = arcRemovedAt.find(ArcKey(arcRecordTails[r], arcRecordHeads[r]));
+                if (removed != arcRemovedAt.end() && !removed->second.empty()) {
+                    cancel(removed->second.back());
+                    cancel(i);
+                    transfers[i] = removed->second.back();
+                    removed->second.pop_back();
+                }
+                arcAddedAt[r] = i;
+                break;
+            }
+            case Operation::ARC_REMOVAL: {
+                ArcKey key(arcRecordTails[r], arcRecordHeads[r]);
+                auto added = arcAddedAt.find(r);
+                if (added == arcAddedAt.end()) {
+                    if (!Operation::isImplicit(codes[i])) {
+                        arcRemovedAt[key].push_back(i);
+                    }
+                    break;
+                }
+                auto t = transfers.find(added->second);
+                if (t != transfers.end()) {
+                    // the arc taken over is removed after all
+                    codes[t->second] &= ~Operation::CANCELLED;
+                    arcRemovedAt[key].push_back(t->second);
+                    transfers.erase(t);
+                }
+                cancel(added->second);
+                cancel(i);
+                arcAddedAt.erase(added);
+                break;
+            }
+            default:
+                break;
+            }
+        }
+    }
+
+    void canonicalizeDeltas() {
+        for (auto tIndex = numCanonicalDeltas; tIndex < timestamps.size(); tIndex++) {
+            if (tIndex == timeIndex && !betweenDeltas()) {
+                throw std::logic_error("Cannot canonicalize a partially applied delta.");
+            }
+            canonicalizeDelta(tIndex);
+        }
+        numCanonicalDeltas = timestamps.size();
+    }
+
+    void setNetDeltas(bool net) {
+        if (net == netDeltas) {
+            return;
+        }
+        if (!betweenDeltas()) {
+            throw std::logic_error("Replay mode can only be changed between deltas.");
+        }
+        netDeltas = net;
+    }
+
     bool nextOp(bool sameTime = false) {
         if (!advance(sameTime)) {
             return false;
         }
-        operations[opIndex]->apply(&dynGraph);
-        opIndex++;
+        const auto maxOp = opCodes.size();
+        bool grouped = true;
+        while (grouped && opIndex < maxOp) {
+            grouped = Operation::isGrouped(opCodes[opIndex]);
+            applyOperation(opIndex);
+            opIndex++;
+        }
         return true;
     }
 
-    bool nextDelta() {
-        if (!advance()) {
-            return false;
+    bool nextDelta() {
+        // expirations at the beginning of the delta belong to it
+        collectingDelta = collectDelta();
+        if (!advance()) {
+            collectingDelta = false;
+            return false;
+        }
+
+        auto maxOp = opCodes.size();
+        if (timeIndex + 1 < timestamps.size()) {
+            maxOp = offset[timeIndex + 1];
+        }
+        Tracer::Scope trace("delta", "graph");
+        trace.arg("time", timestamps[timeIndex]);
+        trace.arg("operations", maxOp - opIndex);
+        PRINT_DEBUG( "Applying delta #op" << opIndex << " - #op" << maxOp)
+        bool wholeDelta = opIndex == offset[timeIndex];
+        DynamicDiGraph::size_type size = 0U;
+        for (; opIndex < maxOp; opIndex++) {
+            if (!Operation::isGrouped(opCodes[opIndex])) {
+                size++;
+            }
+            applyOperation(opIndex);
+        }
+        if (wholeDelta) {
+            lastDeltaSize = size;
+            lastDeltaSizeIndex = timeIndex;
+            lastDeltaSizeEnd = maxOp;
+        }
+        if (collectingDelta) {
+            collectingDelta = false;
+            deliverDelta();
+        }
+
+        if (checkpointInterval > 0U && (timeIndex + 1U) % checkpointInterval == 0U) {
+            takeCheckpoint();
+        }
+        return true;
+    }
+
+    DynamicDiGraph::size_type endOfDelta(DynamicDiGraph::size_type tIndex) const {
+        return tIndex + 1U < offset.size() ? offset[tIndex + 1U] : opCodes.size();
+    }
+
+    void takeCheckpoint() {
+        if (online || windowLength > 0U) {
+            return;
+        }
+        auto pos = std::lower_bound(checkpoints.begin(), checkpoints.end(), opIndex,
+                                    [](const Checkpoint &cp, DynamicDiGraph::size_type oi) {
+            return cp.opIndex < oi;
+        });
+        if (pos != checkpoints.end() && pos->opIndex == opIndex) {
+            return;
+        }
+        Checkpoint cp;
+        cp.timeIndex = timeIndex;
+        cp.opIndex = opIndex;
+        cp.vertexRecords.reserve(dynGraph.getSize());
+        dynGraph.mapVertices([this,&cp](Vertex *v) {
+            cp.vertexRecords.push_back(dynVertexRecords(v));
+        });
+        cp.arcRecords.reserve(dynGraph.getNumArcs(true));
+        dynGraph.mapArcs([this,&cp](Arc *a) {
+            cp.arcRecords.push_back(dynArcRecords(a));
+        });
+        PRINT_DEBUG("Taking checkpoint at #op" << opIndex << " with " << cp.vertexRecords.size()
+                    << " vertices and " << cp.arcRecords.size() << " arcs.")
+        checkpointMemory += cp.memoryUsage();
+        checkpoints.insert(pos, std::move(cp));
+
+        // thin out checkpoints until they fit into the budget
+        while (checkpointMemoryBudget > 0U && checkpointMemory > checkpointMemoryBudget
+               && checkpoints.size() > 1U) {
+            checkpointInterval *= 2U;
+            auto drop = [this](const Checkpoint &cp) {
+                return (cp.timeIndex + 1U) % checkpointInterval != 0U;
+            };
+            checkpointMemory = 0U;
+            checkpoints.erase(std::remove_if(checkpoints.begin(), checkpoints.end(), drop),
+                              checkpoints.end());
+            for (const auto &cp : checkpoints) {
+                checkpointMemory += cp.memoryUsage();
+            }
+        }
+    }
+
+    void clearCheckpoints() {
+        checkpoints.clear();
+        checkpointMemory = 0U;
+    }
+
+    void rebuild(const std::vector<DynamicDiGraph::size_type> &vertexRecords,
+                 const std::vector<DynamicDiGraph::size_type> &arcRecords,
+                 DynamicDiGraph::size_type tIndex, DynamicDiGraph::size_type oIndex) {
+        rebuildNotifying({}, [&]() { rebuildGraph(vertexRecords, arcRecords, tIndex, oIndex); });
+    }
+
+    void rebuildGraph(const std::vector<DynamicDiGraph::size_type> &vertexRecords,
+                      const std::vector<DynamicDiGraph::size_type> &arcRecords,
+                      DynamicDiGraph::size_type tIndex, DynamicDiGraph::size_type oIndex,
+                      bool release = false) {
+        dynGraph.mapArcs([this](Arc *a) {
+            arcRecordArcs[dynArcRecords(a)] = nullptr;
+        });
+        dynGraph.mapVertices([this](Vertex *v) {
+            vertexRecordVertices[dynVertexRecords(v)] = nullptr;
+        });
+        std::fill(slotVertices.begin(), slotVertices.end(), nullptr);
+        if (release) {
+            dynGraph.clearAndRelease();
+            dynGraph.reserveVertexCapacity(vertexRecords.size());
+            dynGraph.reserveArcCapacity(arcRecords.size());
+            dynVertexRecords = FastPropertyMap<DynamicDiGraph::size_type>(NO_RECORD);
+            dynArcRecords = FastPropertyMap<DynamicDiGraph::size_type>(NO_RECORD);
+        } else {
+            dynGraph.clear();
+            dynGraph.reserveVertexCapacity(maxVertexSize);
+            dynGraph.reserveArcCapacity(maxArcSize);
+        }
+        for (auto vr : vertexRecords) {
+            applyVertexAddition(vr);
+        }
+        for (auto ar : arcRecords) {
+            applyArcAddition(ar);
+        }
+        expiryQueue.clear();
+        if (windowLength > 0U) {
+            std::vector<std::pair<DynamicTime, DynamicDiGraph::size_type>> expiries;
+            expiries.reserve(arcRecords.size());
+            for (auto ar : arcRecords) {
+                expiries.emplace_back(arcRecordExpiry[ar], ar);
+            }
+            std::sort(expiries.begin(), expiries.end());
+            expiryQueue.assign(expiries.begin(), expiries.end());
+        }
+        timeIndex = tIndex;
+        opIndex = oIndex;
+    }
+
+    void restoreCheckpoint(const Checkpoint &cp) {
+        PRINT_DEBUG("Restoring checkpoint at #op" << cp.opIndex << ".")
+        rebuild(cp.vertexRecords, cp.arcRecords, cp.timeIndex, cp.opIndex);
+    }
+
+    const Checkpoint *findCheckpoint(DynamicDiGraph::size_type maxOpIndex) const {
+        auto cpPos = std::upper_bound(checkpoints.begin(), checkpoints.end(), maxOpIndex,
+                                      [](DynamicDiGraph::size_type oi, const Checkpoint &cp) {
+            return oi < cp.opIndex;
+        });
+        return cpPos == checkpoints.begin() ? nullptr : &(*(cpPos - 1));
+    }
+
+    // index of the first operation after the last delta with a timestamp not after time
+    DynamicDiGraph::size_type findTarget(DynamicTime time, DynamicDiGraph::size_type &tIndex) const {
+        auto upper = std::upper_bound(timestamps.begin(), timestamps.end(), time);
+        if (upper == timestamps.begin()) {
+            tIndex = 0U;
+            return 0U;
+        }
+        tIndex = static_cast<DynamicDiGraph::size_type>(std::distance(timestamps.begin(), upper) - 1);
+        return endOfDelta(tIndex);
+    }
+
+    void seek(DynamicTime time) {
+        if (timestamps.empty() || online) {
+            return;
+        }
+        DynamicDiGraph::size_type tIndex;
+        auto target = findTarget(time, tIndex);
+
+        if (windowLength > 0U && target < opIndex) {
+            reset();
+        }
+
+        auto curSize = dynGraph.getSize() + dynGraph.getNumArcs(true);
+        auto costReplay = target >= opIndex ? target - opIndex : opIndex - target;
+        auto costReset = curSize + target;
+        const Checkpoint *bestCp = findCheckpoint(target);
+        auto costCp = costReset;
+        if (bestCp) {
+            costCp = curSize + bestCp->vertexRecords.size() + bestCp->arcRecords.size()
+                    + target - bestCp->opIndex;
+        }
+        PRINT_DEBUG("Seeking #op" << target << " from #op" << opIndex << ": replay costs "
+                    << costReplay << ", reset costs " << costReset
+                    << ", checkpoint costs " << costCp << ".")
+
+        if (costReplay > costReset || costReplay > costCp) {
+            if (bestCp && costCp < costReset) {
+                restoreCheckpoint(*bestCp);
+            } else {
+                reset();
+            }
+        }
+        while (opIndex > target) {
+            previousDelta();
+        }
+        while (opIndex < target) {
+            nextDelta();
+        }
+    }
+
+    void fastForward(DynamicTime time) {
+        if (timestamps.empty() || online) {
+            return;
+        }
+        DynamicDiGraph::size_type tIndex;
+        auto target = findTarget(time, tIndex);
+        if (target == 0U) {
+            reset();
+            return;
+        }
+
+        // determine the vertices and arcs present at target by scanning the log;
+        // arcs that are added and removed again in between are never created
+        std::vector<bool> vertexPresent(vertexRecordIds.size(), false);
+        std::vector<bool> arcPresent(arcRecordTails.size(), false);
+        std::vector<DynamicDiGraph::size_type> vertexRecords;
+        std::vector<DynamicDiGraph::size_type> arcRecords;
+        auto addVertexRecord = [&vertexPresent,&vertexRecords](DynamicDiGraph::size_type vr) {
+            vertexPresent[vr] = true;
+            vertexRecords.push_back(vr);
+        };
+        auto addArcRecord = [&arcPresent,&arcRecords](DynamicDiGraph::size_type ar) {
+            arcPresent[ar] = true;
+            arcRecords.push_back(ar);
+        };
+
+        DynamicDiGraph::size_type from = 0U;
+        const Checkpoint *cp = nullptr;
+        if (opIndex > 0U && opIndex <= target) {
+            from = opIndex;
+            dynGraph.mapVertices([&](Vertex *v) { addVertexRecord(dynVertexRecords(v)); });
+            dynGraph.mapArcs([&](Arc *a) { addArcRecord(dynArcRecords(a)); });
+        } else if (windowLength == 0U && (cp = findCheckpoint(target))) {
+            from = cp->opIndex;
+            std::for_each(cp->vertexRecords.begin(), cp->vertexRecords.end(), addVertexRecord);
+            std::for_each(cp->arcRecords.begin(), cp->arcRecords.end(), addArcRecord);
+        } else {
+            std::for_each(antedated.begin(), antedated.end(), addVertexRecord);
         }
+        PRINT_DEBUG("Fast-forwarding from #op" << from << " to #op" << target << ".")
 
-        auto maxOp = operations.size();
-        if (timeIndex + 1 < timestamps.size()) {
-            maxOp = offset[timeIndex + 1];
+        if (windowLength > 0U) {
+            arcRecordExpiry.resize(arcRecordTails.size());
         }
-        PRINT_DEBUG( "Applying delta #op" << opIndex << " - #op" << maxOp)
-        while (opIndex < maxOp) {
-            operations[opIndex]->apply(&dynGraph);
-            opIndex++;
+        DynamicDiGraph::size_type k = std::upper_bound(offset.begin(), offset.end(), from)
+                - offset.begin() - 1;
+        for (auto i = from; i < target; i++) {
+            while (k + 1U < offset.size() && i >= offset[k + 1U]) {
+                k++;
+            }
+            const auto r = opArgs[i];
+            switch (Operation::typeOf(opCodes[i])) {
+            case Operation::VERTEX_ADDITION:
+                addVertexRecord(r);
+                break;
+            case Operation::VERTEX_REMOVAL:
+                vertexPresent[r] = false;
+                break;
+            case Operation::ARC_ADDITION:
+                addArcRecord(r);
+                if (windowLength > 0U) {
+                    arcRecordExpiry[r] = timestamps[k] + windowLength;
+                }
+                break;
+            case Operation::ARC_REMOVAL:
+                arcPresent[r] = false;
+                break;
+            default:
+                break;
+            }
         }
-        return true;
+
+        auto isGone = [](const std::vector<bool> &present) {
+            return [&present](DynamicDiGraph::size_type r) { return !present[r]; };
+        };
+        vertexRecords.erase(std::remove_if(vertexRecords.begin(), vertexRecords.end(),
+                                           isGone(vertexPresent)), vertexRecords.end());
+        if (windowLength > 0U) {
+            for (auto ar : arcRecords) {
+                if (arcRecordExpiry[ar] <= timestamps[tIndex]) {
+                    arcPresent[ar] = false;
+                }
+            }
+        }
+        arcRecords.erase(std::remove_if(arcRecords.begin(), arcRecords.end(),
+                                        isGone(arcPresent)), arcRecords.end());
+
+        rebuild(vertexRecords, arcRecords, tIndex, target);
     }
 
     auto findTimeIndex(DynamicTime timestamp, long long offset = 0) const {
@@ -513,15 +2106,16 @@ struct DynamicDiGraph::CheshireCat {
         if (opIndex == 0U) {
             return false;
         }
-        auto op = operations[opIndex - 1];
-        if (op->getType() == type) {
-            return true;
-        } else if (op->getType() == Operation::Type::MULTIPLE) {
-            OperationSet *os = dynamic_cast<OperationSet*>(op);
-            assert(os);
-            return os->operations.back()->getType() == type;
+        if (type == Operation::Type::MULTIPLE) {
+            auto numExplicit = 0U;
+            for (auto i = findStartOfOperation(opIndex - 1); i < opIndex; i++) {
+                if (!Operation::isImplicit(opCodes[i])) {
+                    numExplicit++;
+                }
+            }
+            return numExplicit > 1U;
         }
-        return false;
+        return Operation::typeOf(opCodes[opIndex - 1]) == type;
     }
 
     DynamicDiGraph::size_type countOperations(DynamicTime timeFrom, DynamicTime timeUntil,
@@ -538,82 +2132,568 @@ struct DynamicDiGraph::CheshireCat {
         auto tIndexUntil = findTimeIndex(timeUntil, tIndexFrom);
         assert(tIndexUntil >= 0);
         auto until = static_cast<DynamicDiGraph::size_type>(tIndexUntil) + 1;
-        auto opIndexMax = until < offset.size() ? offset[until] : operations.size();
-        DynamicDiGraph::size_type numOperations = 0U;
-        for (auto opI = offset[from]; opI < opIndexMax; opI++) {
-            Operation *op = operations[opI];
-            if (op->getType() == type) {
-                numOperations++;
-            } else if (op->getType() == Operation::Type::MULTIPLE) {
-                // there should be no nested operation sets...
-                OperationSet *os = dynamic_cast<OperationSet*>(op);
-                if (os) {
-                    for (Operation *o : os->operations) {
-                        if (o->getType() == type) {
-                            numOperations++;
-                        }
-                    }
+        const auto &countsUntil = until < typeCountsBefore.size() ? typeCountsBefore[until] : typeCounts;
+        return countsUntil[type] - typeCountsBefore[from][type];
+    }
+
+    void clearTemporalIndex() {
+        arcLifetimes.clear();
+        outNeighborLifetimes.clear();
+        inNeighborLifetimes.clear();
+        temporalIndexValid = false;
+    }
+
+    // An arc is present at time t if it has been added in a delta with a timestamp not
+    // after t and not been removed or expired in such a delta since.
+    void buildTemporalIndex() {
+        if (temporalIndexValid) {
+            return;
+        }
+        if (online) {
+            throw std::logic_error("Past states are not available in online mode.");
+        }
+        PRINT_DEBUG("Building temporal index.")
+        clearTemporalIndex();
+
+        const auto forever = std::numeric_limits<DynamicTime>::max();
+        auto addLifetime = [this](DynamicDiGraph::size_type ar, DynamicTime from, DynamicTime until) {
+            if (windowLength > 0U) {
+                // expirations take effect in the first delta at or after the expiry time
+                auto expiry = std::lower_bound(timestamps.begin(), timestamps.end(),
+                                               from + windowLength);
+                if (expiry != timestamps.end() && *expiry < until) {
+                    until = *expiry;
+                }
+            }
+            if (from < until) {
+                arcLifetimes[ArcKey(vertexRecordIds[arcRecordTails[ar]],
+                                    vertexRecordIds[arcRecordHeads[ar]])].emplace_back(from, until);
+            }
+        };
+
+        std::vector<DynamicTime> addedAt(arcRecordTails.size(), forever);
+        DynamicDiGraph::size_type k = 0U;
+        for (DynamicDiGraph::size_type i = 0U; i < opCodes.size(); i++) {
+            while (k + 1U < offset.size() && i >= offset[k + 1U]) {
+                k++;
+            }
+            const auto ar = opArgs[i];
+            switch (Operation::typeOf(opCodes[i])) {
+            case Operation::ARC_ADDITION:
+                addedAt[ar] = timestamps[k];
+                break;
+            case Operation::ARC_REMOVAL:
+                if (addedAt[ar] != forever) {
+                    addLifetime(ar, addedAt[ar], timestamps[k]);
+                    addedAt[ar] = forever;
+                }
+                break;
+            default:
+                break;
+            }
+        }
+        for (DynamicDiGraph::size_type ar = 0U; ar < addedAt.size(); ar++) {
+            if (addedAt[ar] != forever) {
+                addLifetime(ar, addedAt[ar], forever);
+            }
+        }
+
+        // merge lifetimes of parallel arcs and of arcs re-added when removed
+        typedef IntervalTree<VertexIdentifier>::Interval Interval;
+        std::vector<std::vector<Interval>> outIntervals(vertices.size());
+        std::vector<std::vector<Interval>> inIntervals(vertices.size());
+        for (auto &kv : arcLifetimes) {
+            auto &lifetimes = kv.second;
+            std::sort(lifetimes.begin(), lifetimes.end());
+            auto last = lifetimes.begin();
+            for (auto l = lifetimes.begin() + 1; l < lifetimes.end(); l++) {
+                if (l->first <= last->second) {
+                    last->second = std::max(last->second, l->second);
+                } else {
+                    *(++last) = *l;
                 }
             }
+            lifetimes.erase(last + 1, lifetimes.end());
+            lifetimes.shrink_to_fit();
+
+            const auto tailSlot = findSlot(kv.first.first);
+            const auto headSlot = findSlot(kv.first.second);
+            for (const auto &l : lifetimes) {
+                outIntervals[tailSlot].push_back(Interval { l.first, l.second, kv.first.second });
+                inIntervals[headSlot].push_back(Interval { l.first, l.second, kv.first.first });
+            }
+        }
+
+        outNeighborLifetimes.resize(vertices.size());
+        inNeighborLifetimes.resize(vertices.size());
+        for (DynamicDiGraph::size_type slot = 0U; slot < vertices.size(); slot++) {
+            outNeighborLifetimes[slot].build(std::move(outIntervals[slot]));
+            inNeighborLifetimes[slot].build(std::move(inIntervals[slot]));
+        }
+        temporalIndexValid = true;
+    }
+
+    bool wasArcPresent(VertexIdentifier tailId, VertexIdentifier headId, DynamicTime time) {
+        buildTemporalIndex();
+        auto i = arcLifetimes.find(ArcKey(tailId, headId));
+        if (i == arcLifetimes.end()) {
+            return false;
+        }
+        const auto &lifetimes = i->second;
+        auto next = std::upper_bound(lifetimes.begin(), lifetimes.end(), time,
+                                     [](DynamicTime t, const Lifetime &l) { return t < l.first; });
+        return next != lifetimes.begin() && time < (next - 1)->second;
+    }
+
+    std::vector<VertexIdentifier> neighborsAt(VertexIdentifier vertexId, DynamicTime time,
+                                              bool outgoing) {
+        buildTemporalIndex();
+        std::vector<VertexIdentifier> neighbors;
+        auto slot = findSlot(vertexId);
+        if (slot == NO_RECORD) {
+            throw std::invalid_argument("Vertex ID does not exist.");
         }
-        return numOperations;
+        const auto &lifetimes = outgoing ? outNeighborLifetimes : inNeighborLifetimes;
+        lifetimes[slot].stab(time, [&neighbors](VertexIdentifier id) {
+            neighbors.push_back(id);
+        });
+        return neighbors;
     }
 
     void squashTimes(DynamicTime timeFrom, DynamicTime timeUntil) {
+        clearCheckpoints();
+        temporalIndexValid = false;
+        lastDeltaSizeIndex = NO_RECORD;
         auto squashOn = findTimeIndex(timeFrom);
         auto squashMax = findTimeIndex(timeUntil) + 1;
         timestamps.erase(timestamps.cbegin() + squashOn + 1, timestamps.cbegin() + squashMax);
         offset.erase(offset.cbegin() + squashOn + 1, offset.cbegin() + squashMax);
+        typeCountsBefore.erase(typeCountsBefore.cbegin() + squashOn + 1,
+                               typeCountsBefore.cbegin() + squashMax);
+        if (numCanonicalDeltas > static_cast<DynamicDiGraph::size_type>(squashOn)) {
+            numCanonicalDeltas = static_cast<DynamicDiGraph::size_type>(squashOn);
+        }
     }
 
+    // The latest record of an id may not be the current one, e.g., after seeking back
+    // to a time before the vertex was removed and added again.
     Vertex *vertexForId(VertexIdentifier vertexId) const {
-        if (vertexId >= vertices.size() || vertices.at(vertexId) == nullptr) {
-            return nullptr;
-        }
-        return vertices.at(vertexId)->vertex;
+        auto slot = findSlot(vertexId);
+        return slot < slotVertices.size() ? slotVertices[slot] : nullptr;
     }
 
     DynamicDiGraph::size_type getSizeOfLastDelta() {
-        if (timeIndex + 1U == offset.size()) {
-            return operations.size() - offset[timeIndex];
+        auto end = endOfDelta(timeIndex);
+        if (lastDeltaSizeIndex != timeIndex || lastDeltaSizeEnd != end) {
+            lastDeltaSize = countLogicalOperations(offset[timeIndex], end);
+            lastDeltaSizeIndex = timeIndex;
+            lastDeltaSizeEnd = end;
         }
-        return offset[timeIndex + 1U] - offset[timeIndex];
+        return lastDeltaSize;
     }
 
     DynamicDiGraph::size_type getSizeOfFinalDelta() {
-        return operations.size() - offset.back();
-    }
-
-    VertexIdentifier idOfIthVertex(DynamicDiGraph::size_type i) {
-
-        PRINT_DEBUG("Id of " << i <<  "th vertex requested.");
-        PRINT_DEBUG("Size of dynamic graph is " << dynGraph.getSize() << ".");
-        std::function<void(Operation*)> updateMap;
-        updateMap = [this,&updateMap](Operation *op) {
-            if (op->getType() == Operation::Type::VERTEX_ADDITION) {
-                AddVertexOperation *avo = dynamic_cast<AddVertexOperation*>(op);
-                vertexToIdMap[avo->vertex] = avo->vertexId;
-                PRINT_DEBUG("Mapped " << avo->vertex <<  " to id " << avo->vertexId << ".");
-            } else if (op->getType() == Operation::Type::VERTEX_REMOVAL) {
-                RemoveVertexOperation *rvo = dynamic_cast<RemoveVertexOperation*>(op);
-                vertexToIdMap.resetToDefault(rvo->addOp->vertex);
-                PRINT_DEBUG("Removed mapping of " << rvo->addOp->vertex << ".");
-            } else if (op->getType() == Operation::Type::MULTIPLE) {
-                OperationSet *os = dynamic_cast<OperationSet*>(op);
-                for (auto o : os->operations) {
-                    updateMap(o);
+        return countLogicalOperations(offset.back(), opCodes.size());
+    }
+
+    template<typename T>
+    static void writeSection(std::ofstream &out, const T *values, std::uint64_t n) {
+        auto pos = static_cast<std::uint64_t>(out.tellp());
+        std::vector<char> padding(LogHeader::align(pos) - pos, 0);
+        out.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+        out.write(reinterpret_cast<const char*>(values), static_cast<std::streamsize>(n * sizeof(T)));
+    }
+
+    void save(const std::string &fileName) const {
+        LogHeader header;
+        std::copy(LogHeader::MAGIC, LogHeader::MAGIC + 8, header.magic);
+        header.version = LogHeader::VERSION;
+        header.byteOrder = LogHeader::BYTE_ORDER_MARK;
+        header.sizeOfSizeType = sizeof(DynamicDiGraph::size_type);
+        header.sizeOfVertexIdentifier = sizeof(VertexIdentifier);
+        header.sizeOfDynamicTime = sizeof(DynamicTime);
+        header.flags = denseIds ? LogHeader::DENSE_IDS : 0U;
+        header.curVertexSize = curVertexSize;
+        header.curArcSize = curArcSize;
+        header.maxVertexSize = maxVertexSize;
+        header.maxArcSize = maxArcSize;
+        header.nextFreeId = nextFreeId;
+        std::copy(typeCounts.begin(), typeCounts.end(), header.typeCounts);
+        header.sectionLengths[OFFSETS] = offset.size();
+        header.sectionLengths[TYPE_COUNTS] = typeCountsBefore.size();
+        header.sectionLengths[OP_CODES] = opCodes.size();
+        header.sectionLengths[OP_ARGS] = opArgs.size();
+        header.sectionLengths[ANTEDATED] = antedated.size();
+        header.sectionLengths[VERTEX_RECORD_IDS] = vertexRecordIds.size();
+        header.sectionLengths[ARC_RECORD_TAILS] = arcRecordTails.size();
+        header.sectionLengths[ARC_RECORD_HEADS] = arcRecordHeads.size();
+        header.sectionLengths[VERTEX_SLOTS] = vertices.size();
+        header.sectionLengths[SLOT_IDS] = slotIds.size();
+        header.sectionLengths[TIMESTAMPS] = timestamps.size();
+
+        std::ofstream out(fileName, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("Could not open " + fileName + " for writing.");
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(LogHeader));
+        writeSection(out, offset.data(), offset.size());
+        writeSection(out, typeCountsBefore.data(), typeCountsBefore.size());
+        // canonicalization is not saved
+        std::vector<std::uint8_t> codes;
+        writeSection(out, codes.data(), 0U);
+        const DynamicDiGraph::size_type chunkSize = 1U << 16;
+        for (DynamicDiGraph::size_type i = 0U; i < opCodes.size(); i += chunkSize) {
+            codes.assign(opCodes.begin() + i, opCodes.begin() + std::min(i + chunkSize, opCodes.size()));
+            for (auto &code : codes) {
+                code &= ~Operation::CANCELLED;
+            }
+            out.write(reinterpret_cast<const char*>(codes.data()),
+                      static_cast<std::streamsize>(codes.size()));
+        }
+        writeSection(out, opArgs.data(), opArgs.size());
+        writeSection(out, antedated.data(), antedated.size());
+        writeSection(out, vertexRecordIds.data(), vertexRecordIds.size());
+        writeSection(out, arcRecordTails.data(), arcRecordTails.size());
+        writeSection(out, arcRecordHeads.data(), arcRecordHeads.size());
+        writeSection(out, vertices.data(), vertices.size());
+        writeSection(out, slotIds.data(), slotIds.size());
+        writeSection(out, timestamps.data(), timestamps.size());
+        if (!out) {
+            throw std::runtime_error("Could not write " + fileName + ".");
+        }
+    }
+
+    template<typename T>
+    static void readSection(std::ifstream &in, std::uint64_t pos, std::uint64_t n,
+                            std::vector<T> &values) {
+        values.resize(n);
+        in.seekg(static_cast<std::streamoff>(pos));
+        in.read(reinterpret_cast<char*>(values.data()), static_cast<std::streamsize>(n * sizeof(T)));
+    }
+
+    template<typename T>
+    static void readSection(std::ifstream &in, std::uint64_t pos, std::uint64_t n,
+                            LogArray<T> &values) {
+        std::vector<T> v;
+        readSection(in, pos, n, v);
+        values.assign(std::move(v));
+    }
+
+    template<typename T>
+    void mapSection(std::uint64_t pos, std::uint64_t n, LogArray<T> &values) {
+        values.map(reinterpret_cast<T*>(static_cast<char*>(mappedLog.get()) + pos), n, mappedLog);
+    }
+
+    void load(const std::string &fileName, bool mapFile) {
+        clear();
+
+        std::ifstream in(fileName, std::ios::binary);
+        if (!in) {
+            throw std::runtime_error("Could not open " + fileName + " for reading.");
+        }
+        LogHeader header;
+        in.read(reinterpret_cast<char*>(&header), sizeof(LogHeader));
+        if (!in || !std::equal(LogHeader::MAGIC, LogHeader::MAGIC + 8, header.magic)) {
+            throw std::runtime_error(fileName + " is not a dynamic graph log.");
+        }
+        if (header.version != LogHeader::VERSION) {
+            throw std::runtime_error("Unsupported log version " + std::to_string(header.version) + ".");
+        }
+        if (header.byteOrder != LogHeader::BYTE_ORDER_MARK
+                || header.sizeOfSizeType != sizeof(DynamicDiGraph::size_type)
+                || header.sizeOfVertexIdentifier != sizeof(VertexIdentifier)
+                || header.sizeOfDynamicTime != sizeof(DynamicTime)) {
+            throw std::runtime_error(fileName + " was written on an incompatible platform.");
+        }
+
+        const std::uint64_t elementSizes[NUM_SECTIONS] = {
+            sizeof(DynamicDiGraph::size_type), sizeof(TypeCounts), sizeof(std::uint8_t),
+            sizeof(DynamicDiGraph::size_type), sizeof(DynamicDiGraph::size_type),
+            sizeof(VertexIdentifier), sizeof(DynamicDiGraph::size_type),
+            sizeof(DynamicDiGraph::size_type), sizeof(DynamicDiGraph::size_type),
+            sizeof(VertexIdentifier), sizeof(DynamicTime) };
+        in.seekg(0, std::ios::end);
+        const auto fileSize = static_cast<std::uint64_t>(in.tellg());
+        std::uint64_t pos[NUM_SECTIONS];
+        std::uint64_t end = sizeof(LogHeader);
+        for (auto s = 0U; s < NUM_SECTIONS; s++) {
+            pos[s] = LogHeader::align(end);
+            // compared by division so that corrupt lengths cannot overflow
+            if (pos[s] > fileSize || header.sectionLengths[s] > (fileSize - pos[s]) / elementSizes[s]) {
+                throw std::runtime_error(fileName + " is truncated.");
+            }
+            end = pos[s] + header.sectionLengths[s] * elementSizes[s];
+        }
+
+        const auto *len = header.sectionLengths;
+#ifdef DYNDIGRAPH_MMAP
+        if (mapFile) {
+            int fd = open(fileName.c_str(), O_RDONLY);
+            if (fd < 0) {
+                throw std::runtime_error("Could not open " + fileName + " for reading.");
+            }
+            // private mapping: canonicalization may modify operation codes in memory
+            void *log = mmap(nullptr, end, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+            close(fd);
+            if (log == MAP_FAILED) {
+                throw std::runtime_error("Could not map " + fileName + ".");
+            }
+            // unmapped when the last array referring to it is gone
+            mappedLog = std::shared_ptr<void>(log, [end](void *l) { munmap(l, end); });
+            mapSection(pos[OFFSETS], len[OFFSETS], offset);
+            mapSection(pos[TYPE_COUNTS], len[TYPE_COUNTS], typeCountsBefore);
+            mapSection(pos[OP_CODES], len[OP_CODES], opCodes);
+            mapSection(pos[OP_ARGS], len[OP_ARGS], opArgs);
+            mapSection(pos[ANTEDATED], len[ANTEDATED], antedated);
+            mapSection(pos[VERTEX_RECORD_IDS], len[VERTEX_RECORD_IDS], vertexRecordIds);
+            mapSection(pos[ARC_RECORD_TAILS], len[ARC_RECORD_TAILS], arcRecordTails);
+            mapSection(pos[ARC_RECORD_HEADS], len[ARC_RECORD_HEADS], arcRecordHeads);
+            mapSection(pos[VERTEX_SLOTS], len[VERTEX_SLOTS], vertices);
+            mapSection(pos[SLOT_IDS], len[SLOT_IDS], slotIds);
+        }
+#else
+        mapFile = false;
+#endif
+        if (!mapFile) {
+            readSection(in, pos[OFFSETS], len[OFFSETS], offset);
+            readSection(in, pos[TYPE_COUNTS], len[TYPE_COUNTS], typeCountsBefore);
+            readSection(in, pos[OP_CODES], len[OP_CODES], opCodes);
+            readSection(in, pos[OP_ARGS], len[OP_ARGS], opArgs);
+            readSection(in, pos[ANTEDATED], len[ANTEDATED], antedated);
+            readSection(in, pos[VERTEX_RECORD_IDS], len[VERTEX_RECORD_IDS], vertexRecordIds);
+            readSection(in, pos[ARC_RECORD_TAILS], len[ARC_RECORD_TAILS], arcRecordTails);
+            readSection(in, pos[ARC_RECORD_HEADS], len[ARC_RECORD_HEADS], arcRecordHeads);
+            readSection(in, pos[VERTEX_SLOTS], len[VERTEX_SLOTS], vertices);
+            readSection(in, pos[SLOT_IDS], len[SLOT_IDS], slotIds);
+        }
+        readSection(in, pos[TIMESTAMPS], len[TIMESTAMPS], timestamps);
+        if (!in) {
+            clear();
+            throw std::runtime_error("Could not read " + fileName + ".");
+        }
+
+        denseIds = header.flags & LogHeader::DENSE_IDS;
+        if (denseIds) {
+            denseIdMap->reserve(slotIds.size());
+            for (DynamicDiGraph::size_type slot = 0U; slot < slotIds.size(); slot++) {
+                (*denseIdMap)[slotIds[slot]] = slot;
+            }
+        }
+        nextFreeId = header.nextFreeId;
+        curVertexSize = header.curVertexSize;
+        curArcSize = header.curArcSize;
+        maxVertexSize = header.maxVertexSize;
+        maxArcSize = header.maxArcSize;
+        std::copy(header.typeCounts, header.typeCounts + typeCounts.size(), typeCounts.begin());
+
+        if (!isConsistentLog()) {
+            clear();
+            throw std::runtime_error(fileName + " is corrupt.");
+        }
+
+        vertexRecordVertices.assign(vertexRecordIds.size(), nullptr);
+        arcRecordArcs.assign(arcRecordTails.size(), nullptr);
+        constructionStateStale = true;
+        graphChangedSinceLastReset = true;
+    }
+
+    // Whether a loaded log can be replayed safely: all indices are in range, deltas and
+    // timestamps are ordered, and each operation finds its records in the expected state,
+    // which is simulated once over the whole log.
+    bool isConsistentLog() const {
+        const auto numVertexRecords = vertexRecordIds.size();
+        const auto numArcRecords = arcRecordTails.size();
+        if (arcRecordHeads.size() != numArcRecords
+                || offset.size() != timestamps.size()
+                || typeCountsBefore.size() != timestamps.size()
+                || opArgs.size() != opCodes.size()
+                || (denseIds && slotIds.size() != vertices.size())
+                || (timestamps.empty() && !opCodes.empty())) {
+            return false;
+        }
+        for (DynamicDiGraph::size_type t = 0U; t < timestamps.size(); t++) {
+            if (offset[t] > opCodes.size() || (t > 0U && (offset[t] < offset[t - 1U]
+                                                          || timestamps[t] < timestamps[t - 1U]))) {
+                return false;
+            }
+        }
+        if (!timestamps.empty() && offset[0] != 0U) {
+            return false;
+        }
+        for (DynamicDiGraph::size_type ar = 0U; ar < numArcRecords; ar++) {
+            if (arcRecordTails[ar] >= numVertexRecords || arcRecordHeads[ar] >= numVertexRecords) {
+                return false;
+            }
+        }
+        for (DynamicDiGraph::size_type vr = 0U; vr < numVertexRecords; vr++) {
+            if (findSlot(vertexRecordIds[vr]) == NO_RECORD) {
+                return false;
+            }
+        }
+
+        std::vector<bool> vertexPresent(numVertexRecords, false);
+        std::vector<bool> arcPresent(numArcRecords, false);
+        std::vector<DynamicDiGraph::size_type> degrees(numVertexRecords, 0U);
+        DynamicDiGraph::size_type numVertices = 0U;
+        DynamicDiGraph::size_type numArcs = 0U;
+        for (auto vr : antedated) {
+            if (vr >= numVertexRecords || vertexPresent[vr]) {
+                return false;
+            }
+            vertexPresent[vr] = true;
+            numVertices++;
+        }
+        for (DynamicDiGraph::size_type i = 0U; i < opCodes.size(); i++) {
+            const auto code = opCodes[i];
+            const auto r = opArgs[i];
+            if ((code & Operation::TYPE_MASK) > Operation::NONE) {
+                return false;
+            }
+            switch (Operation::typeOf(code)) {
+            case Operation::VERTEX_ADDITION:
+                if (r >= numVertexRecords || vertexPresent[r]) {
+                    return false;
+                }
+                vertexPresent[r] = true;
+                numVertices++;
+                break;
+            case Operation::VERTEX_REMOVAL:
+                if (r >= numVertexRecords || !vertexPresent[r] || degrees[r] > 0U) {
+                    return false;
+                }
+                vertexPresent[r] = false;
+                numVertices--;
+                break;
+            case Operation::ARC_ADDITION:
+                if (r >= numArcRecords || arcPresent[r]
+                        || !vertexPresent[arcRecordTails[r]] || !vertexPresent[arcRecordHeads[r]]) {
+                    return false;
+                }
+                arcPresent[r] = true;
+                degrees[arcRecordTails[r]]++;
+                degrees[arcRecordHeads[r]]++;
+                numArcs++;
+                break;
+            case Operation::ARC_REMOVAL:
+                if (r >= numArcRecords || !arcPresent[r]) {
+                    return false;
                 }
+                arcPresent[r] = false;
+                degrees[arcRecordTails[r]]--;
+                degrees[arcRecordHeads[r]]--;
+                numArcs--;
+                break;
+            default:
+                break;
             }
-        };
+        }
+        if (numVertices != curVertexSize || numArcs != curArcSize
+                || maxVertexSize < curVertexSize || maxVertexSize > numVertexRecords
+                || maxArcSize > numArcRecords) {
+            return false;
+        }
+
+        // slots refer to the vertex records present after the last operation
+        for (DynamicDiGraph::size_type slot = 0U; slot < vertices.size(); slot++) {
+            const auto vr = vertices[slot];
+            if (vr != NO_RECORD && (vr >= numVertexRecords || !vertexPresent[vr]
+                                    || findSlot(vertexRecordIds[vr]) != slot)) {
+                return false;
+            }
+        }
+        for (DynamicDiGraph::size_type vr = 0U; vr < numVertexRecords; vr++) {
+            if (vertexPresent[vr] && vertices[findSlot(vertexRecordIds[vr])] != vr) {
+                return false;
+            }
+        }
+        return true;
+    }
 
-        if (vertexToIdMapNextOpIndex == 0U) {
-            updateMap(&antedated);
+    void shareLog(const CheshireCat &other) {
+        if (other.online) {
+            throw std::logic_error("The log of a graph in online mode cannot be shared.");
         }
-        for (;vertexToIdMapNextOpIndex < opIndex; vertexToIdMapNextOpIndex++) {
-            Operation *op = operations[vertexToIdMapNextOpIndex];
-            updateMap(op);
+        clear();
+
+        timestamps = other.timestamps;
+        offset = other.offset;
+        opCodes = other.opCodes;
+        opArgs = other.opArgs;
+        antedated = other.antedated;
+        typeCountsBefore = other.typeCountsBefore;
+        typeCounts = other.typeCounts;
+        vertexRecordIds = other.vertexRecordIds;
+        arcRecordTails = other.arcRecordTails;
+        arcRecordHeads = other.arcRecordHeads;
+        vertices = other.vertices;
+        slotIds = other.slotIds;
+        denseIds = other.denseIds;
+        denseIdMap = other.denseIdMap;
+        nextFreeId = other.nextFreeId;
+        numCanonicalDeltas = other.numCanonicalDeltas;
+        netTransfers = other.netTransfers;
+        mappedLog = other.mappedLog;
+        curVertexSize = other.curVertexSize;
+        curArcSize = other.curArcSize;
+        maxVertexSize = other.maxVertexSize;
+        maxArcSize = other.maxArcSize;
+
+        vertexRecordVertices.assign(vertexRecordIds.size(), nullptr);
+        arcRecordArcs.assign(arcRecordTails.size(), nullptr);
+        constructionStateStale = !vertexRecordIds.empty();
+        graphChangedSinceLastReset = true;
+    }
+
+    void collectCurrentRecords(std::vector<DynamicDiGraph::size_type> &vertexRecords,
+                               std::vector<DynamicDiGraph::size_type> &arcRecords) {
+        vertexRecords.reserve(dynGraph.getSize());
+        arcRecords.reserve(dynGraph.getNumArcs(true));
+        dynGraph.mapVertices([this,&vertexRecords](Vertex *v) {
+            vertexRecords.push_back(dynVertexRecords(v));
+        });
+        dynGraph.mapArcs([this,&arcRecords](Arc *a) {
+            arcRecords.push_back(dynArcRecords(a));
+        });
+    }
+
+    void defragment() {
+        PRINT_DEBUG("Defragmenting current graph.")
+        std::vector<DynamicDiGraph::size_type> vertexRecords;
+        std::vector<DynamicDiGraph::size_type> arcRecords;
+        collectCurrentRecords(vertexRecords, arcRecords);
+
+        rebuildNotifying(defragmentListeners, [&]() {
+            rebuildGraph(vertexRecords, arcRecords, timeIndex, opIndex, true);
+        });
+        graphChangedSinceLastReset = true;
+    }
+
+    void forkFrom(CheshireCat &other) {
+        shareLog(other);
+
+        doubleArcIsRemoval = other.doubleArcIsRemoval;
+        arcIndexEnabled = other.arcIndexEnabled;
+        lightweightConstruction = other.lightweightConstruction;
+        nameVertices = other.nameVertices;
+        netDeltas = other.netDeltas;
+        windowLength = other.windowLength;
+        arcRecordExpiry = other.arcRecordExpiry;
+        checkpointInterval = other.checkpointInterval;
+        checkpointMemoryBudget = other.checkpointMemoryBudget;
+
+        // keep the order of vertices and arcs in the current graph
+        std::vector<DynamicDiGraph::size_type> vertexRecords;
+        std::vector<DynamicDiGraph::size_type> arcRecords;
+        other.collectCurrentRecords(vertexRecords, arcRecords);
+        rebuild(vertexRecords, arcRecords, other.timeIndex, other.opIndex);
+    }
+
+    VertexIdentifier idOf(const Vertex *v) const {
+        auto vr = dynVertexRecords(v);
+        if (vr == NO_RECORD || vertexRecordVertices[vr] != v) {
+            throw std::invalid_argument("Vertex is not part of the current graph.");
         }
-        return vertexToIdMap(dynGraph.vertexAt(i));
+        return vertexRecordIds[vr];
     }
 };
 
@@ -625,6 +2705,12 @@ DynamicDiGraph::DynamicDiGraph()
 
 DynamicDiGraph::~DynamicDiGraph()
 {
+    for (auto *algorithm : grin->deltaListeners) {
+        algorithm->dynamicDiGraph = nullptr;
+    }
+    for (auto *algorithm : grin->defragmentListeners) {
+        algorithm->dynamicDiGraph = nullptr;
+    }
     delete grin;
 }
 
@@ -635,7 +2721,7 @@ IncidenceListGraph *DynamicDiGraph::getDiGraph() const
 
 DynamicDiGraph::DynamicTime DynamicDiGraph::getCurrentTime() const
 {
-    return grin->timestamps.empty() || (grin->timeIndex == 0U && grin->opIndex == 0U)
+    return grin->timestamps.empty() || grin->atStart()
             ? 0U : grin->timestamps[grin->timeIndex];
 }
 
@@ -666,7 +2752,7 @@ DynamicDiGraph::DynamicTime DynamicDiGraph::getMaxTime() const
 
 const std::vector<DynamicDiGraph::DynamicTime> &DynamicDiGraph::getTimestamps() const
 {
-    return grin->timestamps;
+    return grin->timestamps.vector();
 }
 
 DynamicDiGraph::size_type DynamicDiGraph::getNumberOfDeltas() const
@@ -676,12 +2762,16 @@ DynamicDiGraph::size_type DynamicDiGraph::getNumberOfDeltas() const
 
 DiGraph::size_type DynamicDiGraph::getConstructedGraphSize() const
 {
-    return grin->constructionGraph.getSize();
+    return grin->curVertexSize;
 }
 
 DiGraph::size_type DynamicDiGraph::getConstructedArcSize() const
 {
-    return grin->constructionGraph.getNumArcs(true);
+    if (grin->windowLength > 0U) {
+        // expired arcs are only known once the construction state is restored
+        grin->restoreConstructionState();
+    }
+    return grin->curArcSize - grin->numExpiredArcs;
 }
 
 DynamicDiGraph::VertexIdentifier DynamicDiGraph::addVertex(DynamicTime timestamp)
@@ -702,7 +2792,7 @@ void DynamicDiGraph::removeVertex(VertexIdentifier vertexId, DynamicTime timesta
 void DynamicDiGraph::addArc(VertexIdentifier tailId, VertexIdentifier headId,
                             DynamicTime timestamp, bool antedateVertexAdditions)
 {
-    if (grin->doubleArcIsRemoval && hasArc(tailId, headId)) {
+    if (grin->doubleArcIsRemoval && grin->hasArc(tailId, headId, timestamp)) {
         grin->removeArc(tailId, headId, timestamp, antedateVertexAdditions);
     } else {
         grin->addArc(tailId, headId, timestamp, antedateVertexAdditions);
@@ -722,7 +2812,7 @@ void DynamicDiGraph::noop(DynamicDiGraph::DynamicTime timestamp)
 
 bool DynamicDiGraph::hasArc(VertexIdentifier tailId, VertexIdentifier headId)
 {
-    return grin->findArc(tailId, headId) != nullptr;
+    return grin->hasArc(tailId, headId, grin->finalTime());
 }
 
 void DynamicDiGraph::clear()
@@ -734,14 +2824,16 @@ void DynamicDiGraph::compact(DynamicDiGraph::size_type num)
 {
     if (num < 1U) {
         throw std::invalid_argument("Can only compact positive number of operations.");
-    } else if (num > grin->operations.size() - grin->opIndex) {
-        throw std::invalid_argument("Cannot compact already executed operations.");
     }
     grin->compact(num);
 }
 
 void DynamicDiGraph::resetToBigBang()
 {
+    if (grin->online) {
+        // there is no history to replay
+        return;
+    }
     grin->reset();
 }
 
@@ -755,6 +2847,41 @@ bool DynamicDiGraph::applyNextDelta()
     return grin->nextDelta();
 }
 
+bool DynamicDiGraph::applyPreviousOperation()
+{
+    return grin->previousOp();
+}
+
+bool DynamicDiGraph::applyPreviousDelta()
+{
+    return grin->previousDelta();
+}
+
+void DynamicDiGraph::seekToTime(DynamicTime time)
+{
+    grin->seek(time);
+}
+
+void DynamicDiGraph::fastForwardToTime(DynamicTime time)
+{
+    grin->fastForward(time);
+}
+
+void DynamicDiGraph::setCheckpointInterval(size_type numDeltas)
+{
+    grin->checkpointInterval = numDeltas;
+}
+
+void DynamicDiGraph::setCheckpointMemoryBudget(size_type bytes)
+{
+    grin->checkpointMemoryBudget = bytes;
+}
+
+void DynamicDiGraph::clearCheckpoints()
+{
+    grin->clearCheckpoints();
+}
+
 bool DynamicDiGraph::lastOpWasVertexAddition() const
 {
     return grin->lastOpHadType(Operation::Type::VERTEX_ADDITION);
@@ -792,7 +2919,7 @@ Vertex *DynamicDiGraph::getCurrentVertexForId(VertexIdentifier vertexId) const
 
 DynamicDiGraph::VertexIdentifier DynamicDiGraph::idOfIthVertex(DynamicDiGraph::size_type i)
 {
-    return grin->idOfIthVertex(i);
+    return grin->idOf(grin->dynGraph.vertexAt(i));
 }
 
 DynamicDiGraph::size_type DynamicDiGraph::getSizeOfLastDelta() const
@@ -837,6 +2964,9 @@ DynamicDiGraph::size_type DynamicDiGraph::countNoops(DynamicDiGraph::DynamicTime
 
 void DynamicDiGraph::squashTimes(DynamicTime timeFrom, DynamicTime timeUntil)
 {
+    if (grin->online) {
+        throw std::logic_error("Cannot squash times in online mode.");
+    }
     grin->reset();
     grin->squashTimes(timeFrom, timeUntil);
 }
@@ -846,4 +2976,177 @@ void DynamicDiGraph::secondArcIsRemoval(bool sir)
     grin->doubleArcIsRemoval = sir;
 }
 
+void DynamicDiGraph::useArcIndex(bool use)
+{
+    grin->setArcIndexEnabled(use);
+}
+
+void DynamicDiGraph::useLightweightConstruction(bool lightweight)
+{
+    grin->setLightweightConstruction(lightweight);
+}
+
+void DynamicDiGraph::useDenseVertexIds(bool dense)
+{
+    grin->setDenseIds(dense);
+}
+
+DynamicDiGraph::VertexIdentifier DynamicDiGraph::getDenseVertexId(VertexIdentifier vertexId) const
+{
+    return grin->denseIdOf(vertexId);
+}
+
+DynamicDiGraph::VertexIdentifier DynamicDiGraph::getOriginalVertexId(VertexIdentifier denseId) const
+{
+    return grin->originalIdOf(denseId);
+}
+
+DynamicDiGraph::size_type DynamicDiGraph::getNumberOfVertexIds() const
+{
+    return grin->vertices.size();
+}
+
+DynamicDiGraph::VertexIdentifier DynamicDiGraph::idOf(const Vertex *v) const
+{
+    return grin->idOf(v);
+}
+
+Vertex *DynamicDiGraph::vertexAt(VertexIdentifier vertexId) const
+{
+    return grin->vertexForId(vertexId);
+}
+
+void DynamicDiGraph::setVertexNames(bool names)
+{
+    grin->nameVertices = names;
+}
+
+void DynamicDiGraph::setSlidingWindow(DynamicTime windowLength)
+{
+    grin->setWindowLength(windowLength);
+}
+
+void DynamicDiGraph::useOnlineMode(bool online)
+{
+    grin->setOnline(online);
+}
+
+void DynamicDiGraph::saveLog(const std::string &fileName) const
+{
+    if (grin->online) {
+        // applied operations have been discarded and their records reused
+        throw std::logic_error("The log of a graph in online mode cannot be saved.");
+    }
+    grin->save(fileName);
+}
+
+void DynamicDiGraph::loadLog(const std::string &fileName, bool mapFile)
+{
+    grin->load(fileName, mapFile);
+}
+
+void DynamicDiGraph::shareLogOf(const DynamicDiGraph &other)
+{
+    if (&other == this) {
+        return;
+    }
+    grin->shareLog(*other.grin);
+}
+
+DynamicDiGraph *DynamicDiGraph::fork() const
+{
+    if (grin->online) {
+        throw std::logic_error("A graph in online mode cannot be forked.");
+    }
+    auto *replica = new DynamicDiGraph;
+    replica->grin->forkFrom(*grin);
+    return replica;
+}
+
+bool DynamicDiGraph::wasArcPresentAt(VertexIdentifier tailId, VertexIdentifier headId,
+                                     DynamicTime time) const
+{
+    return grin->wasArcPresent(tailId, headId, time);
+}
+
+std::vector<DynamicDiGraph::VertexIdentifier> DynamicDiGraph::getOutNeighborsAt(
+        VertexIdentifier vertexId, DynamicTime time) const
+{
+    return grin->neighborsAt(vertexId, time, true);
+}
+
+std::vector<DynamicDiGraph::VertexIdentifier> DynamicDiGraph::getInNeighborsAt(
+        VertexIdentifier vertexId, DynamicTime time) const
+{
+    return grin->neighborsAt(vertexId, time, false);
+}
+
+void DynamicDiGraph::defragment()
+{
+    grin->defragment();
+}
+
+// An algorithm listens to at most one DynamicDiGraph, which it remembers so as to remove
+// itself when deleted.
+static void attach(DynamicDiGraph *dyGraph, DynamicDiGraph *&attachedTo)
+{
+    if (attachedTo && attachedTo != dyGraph) {
+        throw std::logic_error("Algorithm already listens to another dynamic graph.");
+    }
+    attachedTo = dyGraph;
+}
+
+void DynamicDiGraph::onDefragment(DynamicDiGraphAlgorithm *algorithm)
+{
+    auto &listeners = grin->defragmentListeners;
+    if (std::find(listeners.begin(), listeners.end(), algorithm) == listeners.end()) {
+        attach(this, algorithm->dynamicDiGraph);
+        listeners.push_back(algorithm);
+    }
+}
+
+void DynamicDiGraph::removeOnDefragment(DynamicDiGraphAlgorithm *algorithm)
+{
+    auto &listeners = grin->defragmentListeners;
+    listeners.erase(std::remove(listeners.begin(), listeners.end(), algorithm), listeners.end());
+    if (std::find(grin->deltaListeners.begin(), grin->deltaListeners.end(), algorithm)
+            == grin->deltaListeners.end() && algorithm->dynamicDiGraph == this) {
+        algorithm->dynamicDiGraph = nullptr;
+    }
+}
+
+void DynamicDiGraph::onDelta(DynamicDiGraphAlgorithm *algorithm)
+{
+    auto &listeners = grin->deltaListeners;
+    if (std::find(listeners.begin(), listeners.end(), algorithm) == listeners.end()) {
+        attach(this, algorithm->dynamicDiGraph);
+        listeners.push_back(algorithm);
+        algorithm->receiveDeltas(true);
+    }
+}
+
+void DynamicDiGraph::removeOnDelta(DynamicDiGraphAlgorithm *algorithm)
+{
+    auto &listeners = grin->deltaListeners;
+    auto i = std::find(listeners.begin(), listeners.end(), algorithm);
+    if (i != listeners.end()) {
+        listeners.erase(i);
+        algorithm->receiveDeltas(false);
+    }
+    if (std::find(grin->defragmentListeners.begin(), grin->defragmentListeners.end(), algorithm)
+            == grin->defragmentListeners.end() && algorithm->dynamicDiGraph == this) {
+        algorithm->dynamicDiGraph = nullptr;
+    }
+}
+
+void DynamicDiGraph::canonicalizeDeltas()
+{
+    grin->canonicalizeDeltas();
+}
+
+void DynamicDiGraph::replayNetDeltas(bool net)
+{
+    grin->setNetDeltas(net);
+}
+
 }
@@ -24,10 +24,13 @@
 #define DYNAMICDIGRAPH_H
 
 #include <vector>
+#include <string>
 #include "graph.incidencelist/incidencelistgraph.h"
 
 namespace Algora {
 
+class DynamicDiGraphAlgorithm;
+
 class DynamicDiGraph
 {
 public:
@@ -62,6 +65,24 @@ public:
     void resetToBigBang();
     bool applyNextOperation(bool sameTimestamp = false);
     bool applyNextDelta();
+    bool applyPreviousOperation();
+    bool applyPreviousDelta();
+    // Move to the state after the last delta with a timestamp not later than time,
+    // either by replaying or undoing deltas or by restoring a checkpoint.
+    // Restoring a checkpoint rebuilds the current graph, just like resetToBigBang().
+    void seekToTime(DynamicTime time);
+    // Like seekToTime(), but without applying operations one by one: the vertices and
+    // arcs present at the target time are determined from the log and the current graph
+    // is rebuilt from them in bulk. Intended for attaching algorithms mid-history: they
+    // should have auto-update disabled (or be attached afterwards) and be run() once the
+    // graph is built.
+    void fastForwardToTime(DynamicTime time);
+    // Checkpoint the current graph after every numDeltas-th delta during replay (0: never).
+    // If the checkpoints exceed the memory budget (0: unlimited), every second one is
+    // dropped and the interval is doubled.
+    void setCheckpointInterval(size_type numDeltas);
+    void setCheckpointMemoryBudget(size_type bytes);
+    void clearCheckpoints();
     bool lastOpWasVertexAddition() const;
     bool lastOpWasVertexRemoval() const;
     bool lastOpWasArcAddition() const;
@@ -70,6 +91,12 @@ public:
     bool lastOpWasNoop() const;
     Vertex *getCurrentVertexForId(VertexIdentifier vertexId) const;
     VertexIdentifier idOfIthVertex(size_type i);
+    // id of a vertex of the current graph
+    VertexIdentifier idOf(const Vertex *v) const;
+    // current vertex with the given id, or nullptr
+    Vertex *vertexAt(VertexIdentifier vertexId) const;
+    // Name vertices of the current graph after their ids (default: true).
+    void setVertexNames(bool names);
     size_type getSizeOfLastDelta() const;
     size_type getSizeOfFinalDelta() const;
 
@@ -79,8 +106,84 @@ public:
     size_type countArcRemovals(DynamicTime timeFrom, DynamicTime timeUntil) const;
     size_type countNoops(DynamicTime timeFrom, DynamicTime timeUntil) const;
 
+    // Whether the graph had an arc from tailId to headId at the given time, i.e., after
+    // the last delta with a timestamp not later than time. Answered from an index over
+    // the log that is built on first use and whenever the log has changed since; the
+    // current graph is not touched. Not available in online mode.
+    bool wasArcPresentAt(VertexIdentifier tailId, VertexIdentifier headId, DynamicTime time) const;
+    // ids of the distinct out- or in-neighbors of a vertex at the given time, see wasArcPresentAt()
+    std::vector<VertexIdentifier> getOutNeighborsAt(VertexIdentifier vertexId, DynamicTime time) const;
+    std::vector<VertexIdentifier> getInNeighborsAt(VertexIdentifier vertexId, DynamicTime time) const;
+
     void squashTimes(DynamicTime timeFrom, DynamicTime timeUntil);
+    // Rebuild the current graph with new vertices and arcs whose ids are dense again, so
+    // that memory indexed by ids shrinks to the size of the current graph after churn.
+    // Algorithms registered with onDefragment() are told before and after and are not
+    // notified of the single changes; others have to be reset.
+    void defragment();
+    void onDefragment(DynamicDiGraphAlgorithm *algorithm);
+    void removeOnDefragment(DynamicDiGraphAlgorithm *algorithm);
+    // Let an algorithm on the current graph receive its changes from here instead of
+    // observing the graph: each delta applied by applyNextDelta() at once via
+    // DynamicDiGraphAlgorithm::onDelta() if all such algorithms receive deltas at once,
+    // all other changes one by one as they are applied. Whenever the current graph is
+    // rebuilt or reset instead, e.g., by seekToTime() or defragment(), the algorithm is
+    // told before and after, see DynamicDiGraphAlgorithm::beforeGraphRebuild().
+    // An algorithm can listen to one DynamicDiGraph only and is removed when deleted.
+    void onDelta(DynamicDiGraphAlgorithm *algorithm);
+    void removeOnDelta(DynamicDiGraphAlgorithm *algorithm);
     void secondArcIsRemoval(bool sir);
+    // Look up arcs by (tailId, headId) in a hash index instead of scanning the tail's
+    // outgoing arcs. Speeds up removeArc(), hasArc() and secondArcIsRemoval(true) on
+    // high-degree vertices at the cost of additional memory.
+    void useArcIndex(bool use);
+    // Validate operations against per-vertex degree counters and incident arc lists
+    // instead of a full mirror graph; implies useArcIndex(true).
+    // Must be set before adding any vertices or arcs.
+    void useLightweightConstruction(bool lightweight);
+    // Map vertex ids to dense ids 0, 1, ... in order of first appearance so that memory
+    // depends on the number of distinct ids rather than on the largest one.
+    // The public interface keeps using the original ids.
+    // Must be set before adding any vertices or arcs.
+    void useDenseVertexIds(bool dense);
+    VertexIdentifier getDenseVertexId(VertexIdentifier vertexId) const;
+    VertexIdentifier getOriginalVertexId(VertexIdentifier denseId) const;
+    // upper bound on dense ids, or on vertex ids if dense ids are disabled
+    size_type getNumberOfVertexIds() const;
+    // Determine which operations cancel each other out within their delta, e.g., an arc
+    // that is added and removed again. Done on demand when replaying net deltas.
+    void canonicalizeDeltas();
+    // Skip cancelled operations during replay, so that each delta is applied with its net
+    // effect only. The log itself is not changed; counts still refer to all operations.
+    // Can only be changed between deltas.
+    void replayNetDeltas(bool net);
+    // Write the operation log to a versioned binary file. Not available in online mode.
+    void saveLog(const std::string &fileName) const;
+    // Replace this graph by a log written with saveLog(). With mapFile, the log is
+    // memory-mapped instead of read; adding operations afterwards copies it into memory.
+    // The log is checked for consistency once when loaded; throws std::runtime_error if
+    // it cannot be read or is corrupt.
+    void loadLog(const std::string &fileName, bool mapFile = true);
+    // Replace this graph by a replay cursor over the operation log of other. The log is
+    // shared, not copied, until either graph adds operations; cursors over the same log
+    // can then be replayed concurrently. Canonicalize deltas before sharing the log to
+    // replay net deltas without copying it.
+    void shareLogOf(const DynamicDiGraph &other);
+    // New graph at the current time of this one that can be changed and replayed
+    // independently; the caller takes ownership. The log is shared as with shareLogOf(),
+    // and the current graph is built in bulk from the present vertices and arcs, in the
+    // same order, instead of replaying the log. Not available in online mode.
+    DynamicDiGraph *fork() const;
+    // Apply operations as soon as they are added and discard them afterwards, so that
+    // memory depends on the size of the current graph only. Times cannot be revisited
+    // and resetToBigBang() has no effect. Must be set before adding any vertices or arcs.
+    void useOnlineMode(bool online);
+    // Let arcs expire windowLength time units after their addition (0: never).
+    // Expired arcs are removed at the beginning of the first delta at or after their
+    // expiry time. Changing the window resets the current graph.
+    // hasArc(), getConstructedArcSize() and secondArcIsRemoval(true) ignore arcs that
+    // have expired by the time in question; removeArc() prefers arcs that have not.
+    void setSlidingWindow(DynamicTime windowLength);
 
 private:
     struct CheshireCat;
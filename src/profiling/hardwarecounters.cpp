@@ -0,0 +1,128 @@
+/**
+ * Copyright (C) 2013 - 2019 : Kathrin Hanauer
+ *
+ * This file is part of Algora.
+ *
+ * Algora is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Algora is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Algora.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact information:
+ *   http://algora.xaikal.org
+ */
+
+#include "hardwarecounters.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+namespace Algora {
+
+#ifdef __linux__
+static int openCounter(unsigned long long config, int groupFd)
+{
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.disabled = groupFd < 0 ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, groupFd, 0));
+}
+#endif
+
+HardwareCounters::HardwareCounters()
+    : numOpen(0U)
+{
+    fds.fill(-1);
+    positions.fill(0U);
+#ifdef __linux__
+    static const unsigned long long configs[NUM_EVENTS] = {
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES };
+
+    fds[CYCLES] = openCounter(configs[CYCLES], -1);
+    if (fds[CYCLES] < 0) {
+        return;
+    }
+    positions[CYCLES] = numOpen++;
+    for (int e = CYCLES + 1; e < NUM_EVENTS; e++) {
+        fds[e] = openCounter(configs[e], fds[CYCLES]);
+        if (fds[e] >= 0) {
+            positions[e] = numOpen++;
+        }
+    }
+    ioctl(fds[CYCLES], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(fds[CYCLES], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+HardwareCounters::~HardwareCounters()
+{
+#ifdef __linux__
+    for (int e = NUM_EVENTS - 1; e >= 0; e--) {
+        if (fds[e] >= 0) {
+            close(fds[e]);
+        }
+    }
+#endif
+}
+
+HardwareCounters::Reading HardwareCounters::read() const
+{
+    Reading reading;
+    reading.fill(0ULL);
+#ifdef __linux__
+    if (!isAvailable()) {
+        return reading;
+    }
+    // number of events, followed by their values
+    unsigned long long values[1 + NUM_EVENTS];
+    auto bytes = ::read(fds[CYCLES], values, sizeof(values));
+    if (bytes < static_cast<decltype(bytes)>(sizeof(unsigned long long))
+            || values[0] != numOpen) {
+        return reading;
+    }
+    for (int e = 0; e < NUM_EVENTS; e++) {
+        if (fds[e] >= 0) {
+            reading[e] = values[1 + positions[e]];
+        }
+    }
+#endif
+    return reading;
+}
+
+const char *HardwareCounters::nameOf(Event event)
+{
+    switch (event) {
+    case CYCLES:
+        return "cycles";
+    case INSTRUCTIONS:
+        return "instructions";
+    case LLC_MISSES:
+        return "llc_misses";
+    case BRANCH_MISSES:
+        return "branch_misses";
+    default:
+        return "";
+    }
+}
+
+}
@@ -0,0 +1,59 @@
+/**
+ * Copyright (C) 2013 - 2019 : Kathrin Hanauer
+ *
+ * This file is part of Algora.
+ *
+ * Algora is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Algora is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Algora.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact information:
+ *   http://algora.xaikal.org
+ */
+
+#ifndef HARDWARECOUNTERS_H
+#define HARDWARECOUNTERS_H
+
+#include <array>
+
+namespace Algora {
+
+// Hardware performance counters of the calling thread, counted in user space via
+// perf_event_open(2) on Linux. If the counters cannot be opened, e.g., due to
+// perf_event_paranoid or on other systems, they are unavailable and read as 0.
+class HardwareCounters
+{
+public:
+    enum Event { CYCLES, INSTRUCTIONS, LLC_MISSES, BRANCH_MISSES, NUM_EVENTS };
+    typedef std::array<unsigned long long, NUM_EVENTS> Reading;
+
+    explicit HardwareCounters();
+    ~HardwareCounters();
+    HardwareCounters(const HardwareCounters &) = delete;
+    HardwareCounters &operator=(const HardwareCounters &) = delete;
+
+    bool isAvailable() const { return fds[CYCLES] >= 0; }
+    bool isAvailable(Event event) const { return fds[event] >= 0; }
+    Reading read() const;
+
+    static const char *nameOf(Event event);
+
+private:
+    std::array<int, NUM_EVENTS> fds;
+    // position of each event in a group read, if available
+    std::array<unsigned int, NUM_EVENTS> positions;
+    unsigned int numOpen;
+};
+
+}
+
+#endif // HARDWARECOUNTERS_H
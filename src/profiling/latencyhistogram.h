@@ -0,0 +1,47 @@
+/**
+ * Copyright (C) 2013 - 2019 : Kathrin Hanauer
+ *
+ * This file is part of Algora.
+ *
+ * Algora is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Algora is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Algora.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact information:
+ *   http://algora.xaikal.org
+ */
+
+
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+#include "loghistogram.h"
+
+#include <chrono>
+
+namespace Algora {
+
+// LogHistogram of latencies in nanoseconds
+class LatencyHistogram : public LogHistogram
+{
+public:
+    typedef std::chrono::steady_clock clock;
+
+    void recordSince(clock::time_point start) {
+        record(static_cast<value_type>(
+                   std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count()));
+    }
+};
+
+}
+
+#endif // LATENCYHISTOGRAM_H
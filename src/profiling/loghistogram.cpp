@@ -0,0 +1,66 @@
+/**
+ * Copyright (C) 2013 - 2019 : Kathrin Hanauer
+ *
+ * This file is part of Algora.
+ *
+ * Algora is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Algora is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Algora.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact information:
+ *   http://algora.xaikal.org
+ */
+
+#include "loghistogram.h"
+
+#include <cmath>
+
+namespace Algora {
+
+void LogHistogram::clear()
+{
+    buckets.clear();
+    count = 0ULL;
+    maximum = 0ULL;
+}
+
+LogHistogram::value_type LogHistogram::getPercentile(double q) const
+{
+    if (count == 0ULL) {
+        return 0ULL;
+    }
+    auto rank = static_cast<value_type>(std::ceil(q * static_cast<double>(count)));
+    if (rank == 0ULL) {
+        rank = 1ULL;
+    }
+    value_type seen = 0ULL;
+    for (unsigned int b = 0U; b < buckets.size(); b++) {
+        seen += buckets[b];
+        if (seen >= rank) {
+            auto value = largestValueIn(b);
+            return value < maximum ? value : maximum;
+        }
+    }
+    return maximum;
+}
+
+LogHistogram::value_type LogHistogram::largestValueIn(unsigned int bucket)
+{
+    if (bucket < 2U * SUB_BUCKETS) {
+        return bucket;
+    }
+    auto shift = (bucket - 2U * SUB_BUCKETS) / SUB_BUCKETS + 1U;
+    auto top = SUB_BUCKETS + (bucket - 2U * SUB_BUCKETS) % SUB_BUCKETS;
+    return ((top + 1ULL) << shift) - 1ULL;
+}
+
+}
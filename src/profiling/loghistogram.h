@@ -0,0 +1,82 @@
+/**
+ * Copyright (C) 2013 - 2019 : Kathrin Hanauer
+ *
+ * This file is part of Algora.
+ *
+ * Algora is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Algora is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Algora.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact information:
+ *   http://algora.xaikal.org
+ */
+
+
+#ifndef LOGHISTOGRAM_H
+#define LOGHISTOGRAM_H
+
+#include <vector>
+
+namespace Algora {
+
+// Histogram of non-negative values with logarithmic buckets, each power of two being
+// split into 16 linear sub-buckets, so that percentiles are exact up to 31 and within
+// 1/16 of the value above. Recording is amortized constant time; buckets are allocated
+// up to the largest recorded value only.
+class LogHistogram
+{
+public:
+    typedef unsigned long long value_type;
+
+    explicit LogHistogram() : count(0ULL), maximum(0ULL) { }
+
+    void record(value_type value) {
+        auto bucket = bucketOf(value);
+        if (bucket >= buckets.size()) {
+            buckets.resize(bucket + 1U, 0ULL);
+        }
+        buckets[bucket]++;
+        count++;
+        if (value > maximum) {
+            maximum = value;
+        }
+    }
+    void clear();
+
+    value_type getCount() const { return count; }
+    value_type getMax() const { return maximum; }
+    // smallest recorded value such that a fraction of at least q of all recorded
+    // values is not larger, up to bucket precision; 0 if nothing has been recorded
+    value_type getPercentile(double q) const;
+
+private:
+    static constexpr unsigned int SUB_BUCKET_BITS = 4U;
+    static constexpr value_type SUB_BUCKETS = 1ULL << SUB_BUCKET_BITS;
+
+    std::vector<value_type> buckets;
+    value_type count;
+    value_type maximum;
+
+    static unsigned int bucketOf(value_type value) {
+        if (value < 2U * SUB_BUCKETS) {
+            return static_cast<unsigned int>(value);
+        }
+        unsigned int shift = 63U - static_cast<unsigned int>(__builtin_clzll(value)) - SUB_BUCKET_BITS;
+        return static_cast<unsigned int>(2U * SUB_BUCKETS + (shift - 1U) * SUB_BUCKETS
+                                         + ((value >> shift) - SUB_BUCKETS));
+    }
+    static value_type largestValueIn(unsigned int bucket);
+};
+
+}
+
+#endif // LOGHISTOGRAM_H
@@ -0,0 +1,58 @@
+/**
+ * Copyright (C) 2013 - 2019 : Kathrin Hanauer
+ *
+ * This file is part of Algora.
+ *
+ * Algora is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Algora is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Algora.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact information:
+ *   http://algora.xaikal.org
+ */
+
+#ifndef PROFILING_H
+#define PROFILING_H
+
+#include <type_traits>
+
+namespace Algora {
+
+// Values for the profiling template parameter of algorithms: with On, detailed
+// counters are collected, with Off, they are compiled out. Both variants can be
+// used in the same binary. Default follows the COLLECT_PR_DATA build flag
+// (qmake config "profiling").
+namespace Profiling {
+constexpr bool On = true;
+constexpr bool Off = false;
+#ifdef COLLECT_PR_DATA
+constexpr bool Default = On;
+#else
+constexpr bool Default = Off;
+#endif
+
+// Members of type T that only exist with profiling, taking no space otherwise if declared
+// [[no_unique_address]]. They must only be accessed in if constexpr (profiling) blocks.
+template<typename T>
+struct Omitted {
+    Omitted() = default;
+    // takes the constructor arguments of T
+    template<typename... Args>
+    explicit Omitted(Args&&...) { }
+};
+template<bool profiling, typename T>
+using Storage = std::conditional_t<profiling, T, Omitted<T>>;
+}
+
+}
+
+#endif // PROFILING_H
@@ -0,0 +1,15 @@
+message("pri file being processed: $$PWD")
+
+HEADERS += \
+    $$PWD/hardwarecounters.h \
+    $$PWD/latencyhistogram.h \
+    $$PWD/loghistogram.h \
+    $$PWD/profiling.h \
+    $$PWD/tracer.h \
+    $$PWD/updatedistributions.h
+
+SOURCES += \
+    $$PWD/hardwarecounters.cpp \
+    $$PWD/loghistogram.cpp \
+    $$PWD/tracer.cpp \
+    $$PWD/updatedistributions.cpp
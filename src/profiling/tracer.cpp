@@ -0,0 +1,179 @@
+/**
+ * Copyright (C) 2013 - 2019 : Kathrin Hanauer
+ *
+ * This file is part of Algora.
+ *
+ * Algora is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Algora is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Algora.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact information:
+ *   http://algora.xaikal.org
+ */
+
+#include "tracer.h"
+
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+namespace Algora {
+
+namespace {
+
+// single-producer ring buffer, owned by the registry so that events outlive their thread
+struct ThreadBuffer {
+    std::vector<Tracer::Event> events;
+    std::atomic<unsigned long long> recorded;
+    // number of events recorded before the last clear(); recorded itself is only
+    // written by the owning thread
+    std::atomic<unsigned long long> cleared;
+    unsigned long long threadId;
+
+    ThreadBuffer(std::size_t capacity, unsigned long long tid)
+        : events(capacity), recorded(0ULL), cleared(0ULL), threadId(tid) { }
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    std::size_t capacity = 1U << 16;
+    Tracer::clock::time_point epoch = Tracer::clock::now();
+};
+
+Registry &registry()
+{
+    static Registry r;
+    return r;
+}
+
+ThreadBuffer &threadBuffer()
+{
+    thread_local std::shared_ptr<ThreadBuffer> buffer;
+    if (!buffer) {
+        auto &r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        buffer = std::make_shared<ThreadBuffer>(r.capacity, r.buffers.size() + 1U);
+        r.buffers.push_back(buffer);
+    }
+    return *buffer;
+}
+
+void writeString(std::ostream &os, const char *s)
+{
+    os << '"';
+    for (; *s; s++) {
+        if (*s == '"' || *s == '\\') {
+            os << '\\';
+        }
+        os << *s;
+    }
+    os << '"';
+}
+
+}
+
+std::atomic<bool> &Tracer::enabled()
+{
+    static std::atomic<bool> on(false);
+    return on;
+}
+
+void Tracer::enable(bool on)
+{
+    // timestamps are relative to the creation of the registry
+    registry();
+    enabled().store(on, std::memory_order_relaxed);
+}
+
+void Tracer::setBufferCapacity(std::size_t numEvents)
+{
+    if (numEvents == 0U) {
+        throw std::invalid_argument("Trace buffer capacity must be positive.");
+    }
+    auto &r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.capacity = numEvents;
+}
+
+void Tracer::record(const Event &event)
+{
+    auto &buffer = threadBuffer();
+    auto n = buffer.recorded.load(std::memory_order_relaxed);
+    buffer.events[n % buffer.events.size()] = event;
+    buffer.recorded.store(n + 1U, std::memory_order_release);
+}
+
+void Tracer::writeJson(const std::string &fileName)
+{
+    std::ofstream out(fileName);
+    if (!out) {
+        throw std::runtime_error("Could not open " + fileName + " for writing.");
+    }
+    auto &r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+
+    auto micros = [](clock::duration d) {
+        return std::chrono::duration<double, std::micro>(d).count();
+    };
+    // nanosecond resolution regardless of the magnitude of timestamps
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+    for (const auto &buffer : r.buffers) {
+        auto recorded = buffer->recorded.load(std::memory_order_acquire);
+        auto capacity = static_cast<unsigned long long>(buffer->events.size());
+        auto begin = recorded > capacity ? recorded - capacity : 0ULL;
+        auto cleared = buffer->cleared.load(std::memory_order_relaxed);
+        if (begin < cleared) {
+            begin = cleared;
+        }
+        for (auto i = begin; i < recorded; i++) {
+            const auto &event = buffer->events[i % capacity];
+            out << (first ? "\n" : ",\n") << "{\"name\":";
+            writeString(out, event.name);
+            out << ",\"cat\":";
+            writeString(out, event.category);
+            out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadId
+                << ",\"ts\":" << micros(event.start - r.epoch)
+                << ",\"dur\":" << micros(event.duration);
+            if (event.numArgs > 0U) {
+                out << ",\"args\":{";
+                for (auto a = 0U; a < event.numArgs; a++) {
+                    if (a > 0U) {
+                        out << ',';
+                    }
+                    writeString(out, event.argKeys[a]);
+                    out << ':' << event.argValues[a];
+                }
+                out << '}';
+            }
+            out << '}';
+            first = false;
+        }
+    }
+    out << "\n]}\n";
+}
+
+void Tracer::clear()
+{
+    auto &r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (auto &buffer : r.buffers) {
+        buffer->cleared.store(buffer->recorded.load(std::memory_order_acquire),
+                              std::memory_order_relaxed);
+    }
+}
+
+}
@@ -0,0 +1,105 @@
+/**
+ * Copyright (C) 2013 - 2019 : Kathrin Hanauer
+ *
+ * This file is part of Algora.
+ *
+ * Algora is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Algora is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Algora.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact information:
+ *   http://algora.xaikal.org
+ */
+
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace Algora {
+
+// Process-wide event tracer writing Chrome trace-event JSON, which can be viewed in
+// chrome://tracing or Perfetto. Each thread records into a ring buffer of its own
+// without locking, keeping the most recent events; recording costs a relaxed atomic
+// load while disabled. Names, categories and argument keys must be string literals.
+class Tracer
+{
+public:
+    typedef std::chrono::steady_clock clock;
+    typedef long long arg_type;
+    static constexpr unsigned int MAX_ARGS = 3U;
+
+    struct Event {
+        const char *name;
+        const char *category;
+        clock::time_point start;
+        clock::duration duration;
+        unsigned int numArgs;
+        const char *argKeys[MAX_ARGS];
+        arg_type argValues[MAX_ARGS];
+    };
+
+    static void enable(bool on);
+    static bool isEnabled() { return enabled().load(std::memory_order_relaxed); }
+    // ring buffer size of threads that record their first event afterwards
+    static void setBufferCapacity(std::size_t numEvents);
+    static void record(const Event &event);
+    // Write all buffered events. Threads should not record meanwhile.
+    static void writeJson(const std::string &fileName);
+    // Discard all buffered events; safe while threads record.
+    static void clear();
+
+    // Records a complete event from construction to destruction, if tracing is enabled.
+    class Scope {
+    public:
+        Scope(const char *name, const char *category)
+            : active(Tracer::isEnabled()) {
+            if (active) {
+                event.name = name;
+                event.category = category;
+                event.numArgs = 0U;
+                event.start = clock::now();
+            }
+        }
+        ~Scope() {
+            if (active) {
+                event.duration = clock::now() - event.start;
+                Tracer::record(event);
+            }
+        }
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+        // attach an argument; ignored beyond MAX_ARGS
+        void arg(const char *key, arg_type value) {
+            if (active && event.numArgs < MAX_ARGS) {
+                event.argKeys[event.numArgs] = key;
+                event.argValues[event.numArgs] = value;
+                event.numArgs++;
+            }
+        }
+
+    private:
+        bool active;
+        Event event;
+    };
+
+private:
+    static std::atomic<bool> &enabled();
+};
+
+}
+
+#endif // TRACER_H
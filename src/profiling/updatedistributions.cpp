@@ -0,0 +1,63 @@
+/**
+ * Copyright (C) 2013 - 2019 : Kathrin Hanauer
+ *
+ * This file is part of Algora.
+ *
+ * Algora is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Algora is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Algora.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact information:
+ *   http://algora.xaikal.org
+ */
+
+
+#include "updatedistributions.h"
+
+namespace Algora {
+
+void UpdateDistributions::clear()
+{
+    for (auto &histogram : histograms) {
+        histogram.clear();
+    }
+}
+
+void UpdateDistributions::addTo(Profile &profile) const
+{
+    static const char *updateNames[NUM_UPDATES] = {
+        "tree_arc_add", "nontree_arc_add", "tree_arc_remove", "nontree_arc_remove" };
+    static const char *measureNames[NUM_MEASURES] = {
+        "affected", "arcs", "level_changes", "requeues" };
+
+    for (unsigned int u = 0U; u < NUM_UPDATES; u++) {
+        auto count = histograms[u * NUM_MEASURES].getCount();
+        if (count == 0ULL) {
+            continue;
+        }
+        profile.emplace_back(std::string(updateNames[u]) + "_updates", count);
+        auto numMeasures = levels ? NUM_MEASURES : 2U;
+        for (unsigned int m = 0U; m < numMeasures; m++) {
+            const auto &histogram = histograms[u * NUM_MEASURES + m];
+            if (histogram.getMax() == 0ULL) {
+                continue;
+            }
+            std::string prefix = std::string(updateNames[u]) + "_" + measureNames[m] + "_";
+            profile.emplace_back(prefix + "p50", histogram.getPercentile(0.5));
+            profile.emplace_back(prefix + "p90", histogram.getPercentile(0.9));
+            profile.emplace_back(prefix + "p99", histogram.getPercentile(0.99));
+            profile.emplace_back(prefix + "max", histogram.getMax());
+        }
+    }
+}
+
+}
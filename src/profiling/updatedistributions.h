@@ -0,0 +1,83 @@
+/**
+ * Copyright (C) 2013 - 2019 : Kathrin Hanauer
+ *
+ * This file is part of Algora.
+ *
+ * Algora is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Algora is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Algora.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact information:
+ *   http://algora.xaikal.org
+ */
+
+
+#ifndef UPDATEDISTRIBUTIONS_H
+#define UPDATEDISTRIBUTIONS_H
+
+#include "loghistogram.h"
+
+#include <array>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Algora {
+
+// Per-update distributions of the work done by an incremental single-source algorithm,
+// separately for arc additions and removals that change the tree and those that do not.
+class UpdateDistributions
+{
+public:
+    typedef LogHistogram::value_type value_type;
+    typedef std::vector<std::pair<std::string, value_type>> Profile;
+
+    enum class Update { TreeArcAdd, NonTreeArcAdd, TreeArcRemove, NonTreeArcRemove };
+    enum class Measure { AffectedVertices, TraversedArcs, LevelChanges, Requeues };
+
+    struct Sample {
+        value_type affectedVertices;
+        value_type traversedArcs;
+        value_type levelChanges;
+        value_type requeues;
+    };
+
+    // levels: whether level changes and requeues apply to the algorithm
+    explicit UpdateDistributions(bool withLevels = true) : levels(withLevels) { }
+
+    void record(Update update, const Sample &sample) {
+        auto *h = &histograms[static_cast<unsigned int>(update) * NUM_MEASURES];
+        h[0].record(sample.affectedVertices);
+        h[1].record(sample.traversedArcs);
+        h[2].record(sample.levelChanges);
+        h[3].record(sample.requeues);
+    }
+    void clear();
+
+    const LogHistogram &get(Update update, Measure measure) const {
+        return histograms[static_cast<unsigned int>(update) * NUM_MEASURES
+                + static_cast<unsigned int>(measure)];
+    }
+    // append <update>_updates and <update>_<measure>_{p50,p90,p99,max} per kind of
+    // update that has occurred, omitting measures that have always been 0
+    void addTo(Profile &profile) const;
+
+private:
+    static constexpr unsigned int NUM_UPDATES = 4U;
+    static constexpr unsigned int NUM_MEASURES = 4U;
+    std::array<LogHistogram, NUM_UPDATES * NUM_MEASURES> histograms;
+    bool levels;
+};
+
+}
+
+#endif // UPDATEDISTRIBUTIONS_H
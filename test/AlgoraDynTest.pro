@@ -0,0 +1,81 @@
+########################################################################
+# Copyright (C) 2013 - 2019 : Kathrin Hanauer                          #
+#                                                                      #
+# This file is part of Algora.                                         #
+#                                                                      #
+# Algora is free software: you can redistribute it and/or modify       #
+# it under the terms of the GNU General Public License as published by #
+# the Free Software Foundation, either version 3 of the License, or    #
+# (at your option) any later version.                                  #
+#                                                                      #
+# Algora is distributed in the hope that it will be useful,            #
+# but WITHOUT ANY WARRANTY; without even the implied warranty of       #
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        #
+# GNU General Public License for more details.                         #
+#                                                                      #
+# You should have received a copy of the GNU General Public License    #
+# along with Algora.  If not, see <http://www.gnu.org/licenses/>.      #
+#                                                                      #
+# Contact information:                                                 #
+#   http://algora.xaikal.org                                           #
+########################################################################
+
+
+QT       -= core gui
+
+TARGET = AlgoraDynTest
+TEMPLATE = app
+CONFIG += console c++17
+CONFIG -= app_bundle
+
+QMAKE_CXXFLAGS_DEBUG += -std=c++17 -O0
+
+QMAKE_CXXFLAGS_RELEASE -= -O1 -O2 -O3
+QMAKE_CXXFLAGS_RELEASE += -std=c++17 -O2 -flto
+QMAKE_LFLAGS_RELEASE += -flto
+
+profiling {
+	QMAKE_CXXFLAGS_DEBUG   += -DCOLLECT_PR_DATA
+	QMAKE_CXXFLAGS_RELEASE += -DCOLLECT_PR_DATA
+}
+
+CONFIG(debug, debug|release) {
+  ALGORA_BUILD = Debug
+} else {
+  ALGORA_BUILD = Release
+}
+
+# AlgoraDyn is expected in ../build/<Debug|Release>, AlgoraCore next to it,
+# as built by easyCompile
+LIBS += -L$$PWD/../build/$$ALGORA_BUILD -lAlgoraDyn
+LIBS += -L$$PWD/../../AlgoraCore/build/$$ALGORA_BUILD -lAlgoraCore
+unix: LIBS += -lpthread
+
+PRE_TARGETDEPS += $$PWD/../build/$$ALGORA_BUILD/libAlgoraDyn.a
+
+INCLUDEPATH += $$PWD/../src
+INCLUDEPATH += $$PWD/../../AlgoraCore/src
+
+DEPENDPATH += $$PWD/../src
+DEPENDPATH += $$PWD/../../AlgoraCore/src
+
+HEADERS += \
+    $$PWD/randomlog.h \
+    $$PWD/test.h
+
+SOURCES += \
+    $$PWD/constructiontest.cpp \
+    $$PWD/defragmenttest.cpp \
+    $$PWD/deltalistenertest.cpp \
+    $$PWD/grouptest.cpp \
+    $$PWD/histogramtest.cpp \
+    $$PWD/main.cpp \
+    $$PWD/onlinetest.cpp \
+    $$PWD/randomlog.cpp \
+    $$PWD/replaytest.cpp \
+    $$PWD/savelogtest.cpp \
+    $$PWD/sharetest.cpp \
+    $$PWD/statictest.cpp \
+    $$PWD/temporaltest.cpp \
+    $$PWD/tracertest.cpp \
+    $$PWD/windowtest.cpp
@@ -0,0 +1,116 @@
+/**
+ * Copyright (C) 2013 - 2019 : Kathrin Hanauer
+ *
+ * This file is part of Algora.
+ *
+ * Algora is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Algora is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Algora.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact information:
+ *   http://algora.xaikal.org
+ */
+
+#include "test.h"
+#include "randomlog.h"
+
+namespace Algora {
+
+static constexpr DynamicTime NUM_DELTAS = 200U;
+
+// hasArc() answers from the construction state, i.e., after all operations added so far
+static void checkHasArc(DynamicDiGraph &dyGraph, const Snapshot &expected, VertexIdentifier idFactor)
+{
+    for (VertexIdentifier tail = 0U; tail < RandomLogGenerator::NUM_IDS; tail++) {
+        for (VertexIdentifier head = 0U; head < RandomLogGenerator::NUM_IDS; head++) {
+            CHECK(dyGraph.hasArc(tail * idFactor, head * idFactor)
+                  == expected.hasArc(tail * idFactor, head * idFactor));
+        }
+    }
+}
+
+void testArcIndex()
+{
+    DynamicDiGraph dyGraph;
+    dyGraph.useArcIndex(true);
+    auto expected = generateRandomLog(dyGraph, 11U, NUM_DELTAS);
+    checkHasArc(dyGraph, expected.back(), 1U);
+    CHECK(replayDeltaByDelta(dyGraph) == expected);
+
+    // enabling the index later builds it from the construction graph
+    DynamicDiGraph late;
+    RandomLogGenerator generator(12U);
+    std::vector<Snapshot> lateExpected(1U);
+    for (DynamicTime t = 1U; t <= NUM_DELTAS; t++) {
+        if (t == NUM_DELTAS / 2U) {
+            late.useArcIndex(true);
+            checkHasArc(late, generator.getSnapshot(), 1U);
+        }
+        generator.addDelta(late, t);
+        lateExpected.push_back(generator.getSnapshot());
+    }
+    checkHasArc(late, lateExpected.back(), 1U);
+    late.useArcIndex(false);
+    checkHasArc(late, lateExpected.back(), 1U);
+    CHECK(replayDeltaByDelta(late) == lateExpected);
+}
+
+void testLightweightConstruction()
+{
+    DynamicDiGraph dyGraph;
+    dyGraph.useLightweightConstruction(true);
+    auto expected = generateRandomLog(dyGraph, 21U, NUM_DELTAS);
+    checkHasArc(dyGraph, expected.back(), 1U);
+    CHECK(replayDeltaByDelta(dyGraph) == expected);
+
+    // removing isolated ends is decided from the degree counters
+    DynamicDiGraph ends;
+    ends.useLightweightConstruction(true);
+    ends.addArc(0U, 1U, 1U);
+    ends.addArc(1U, 2U, 1U);
+    ends.addArc(1U, 1U, 1U);
+    ends.removeArc(0U, 1U, 2U, true);
+    ends.removeArc(1U, 1U, 3U, true);
+    ends.removeArc(1U, 2U, 4U, true);
+    ends.addArc(3U, 3U, 5U);
+    ends.removeArc(3U, 3U, 6U, true);
+    std::vector<Snapshot> endsExpected(7U);
+    endsExpected[1] = Snapshot{ { 0U, 1U, 2U }, { { 0U, 1U }, { 1U, 1U }, { 1U, 2U } } };
+    endsExpected[2] = Snapshot{ { 1U, 2U }, { { 1U, 1U }, { 1U, 2U } } };
+    endsExpected[3] = Snapshot{ { 1U, 2U }, { { 1U, 2U } } };
+    endsExpected[5] = Snapshot{ { 3U }, { { 3U, 3U } } };
+    CHECK(replayDeltaByDelta(ends) == endsExpected);
+}
+
+void testDenseVertexIds()
+{
+    // sparse ids far beyond the number of vertices
+    const VertexIdentifier idFactor = 1000000007U;
+    DynamicDiGraph dyGraph;
+    dyGraph.useDenseVertexIds(true);
+    auto expected = generateRandomLog(dyGraph, 31U, NUM_DELTAS, idFactor);
+    CHECK(dyGraph.getNumberOfVertexIds() <= RandomLogGenerator::NUM_IDS);
+    for (auto id : expected.back().vertices) {
+        auto denseId = dyGraph.getDenseVertexId(id);
+        CHECK(denseId < dyGraph.getNumberOfVertexIds());
+        CHECK(dyGraph.getOriginalVertexId(denseId) == id);
+    }
+    checkHasArc(dyGraph, expected.back(), idFactor);
+    CHECK(replayDeltaByDelta(dyGraph) == expected);
+    dyGraph.seekToTime(NUM_DELTAS / 2U);
+    for (auto id : expected[NUM_DELTAS / 2U].vertices) {
+        auto *v = dyGraph.vertexAt(id);
+        CHECK(v != nullptr && dyGraph.idOf(v) == id);
+    }
+}
+
+}
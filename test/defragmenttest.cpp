@@ -0,0 +1,114 @@
+/**
+ * Copyright (C) 2013 - 2019 : Kathrin Hanauer
+ *
+ * This file is part of Algora.
+ *
+ * Algora is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Algora is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Algora.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact information:
+ *   http://algora.xaikal.org
+ */
+
+
+#include "test.h"
+#include "randomlog.h"
+
+#include "algorithm/dynamicdigraphalgorithm.h"
+#include "graph/vertex.h"
+
+#include <random>
+
+namespace Algora {
+
+// Holds on to a vertex across rebuilds and counts the changes it observes.
+class TrackingAlgorithm : public DynamicDiGraphAlgorithm
+{
+public:
+    Vertex *tracked = nullptr;
+    unsigned int numChanges = 0U;
+    unsigned int numRebuilds = 0U;
+    bool rebuilding = false;
+
+    // DiGraphAlgorithm interface
+    virtual void run() override { }
+    virtual std::string getName() const noexcept override { return "Tracking Algorithm"; }
+    virtual std::string getShortName() const noexcept override { return "Tracking"; }
+
+    // DynamicDiGraphAlgorithm interface
+    virtual void onVertexAdd(Vertex *) override { numChanges++; }
+    virtual void onVertexRemove(Vertex *) override { numChanges++; }
+    virtual void onArcAdd(Arc *) override { numChanges++; }
+    virtual void onArcRemove(Arc *) override { numChanges++; }
+
+protected:
+    virtual void onGraphRebuildBegin() override {
+        rebuilding = true;
+    }
+    virtual void onGraphRebuilt(const VertexRemapping &remap) override {
+        rebuilding = false;
+        numRebuilds++;
+        if (tracked) {
+            tracked = remap(tracked);
+        }
+    }
+};
+
+void testDefragment()
+{
+    for (auto seed : { 101U, 102U }) {
+        DynamicDiGraph dyGraph;
+        auto expected = generateRandomLog(dyGraph, seed, 200U);
+        dyGraph.resetToBigBang();
+
+        TrackingAlgorithm algorithm;
+        algorithm.setGraph(dyGraph.getDiGraph());
+        dyGraph.onDefragment(&algorithm);
+        // deleted algorithms are not told anymore
+        auto *deleted = new TrackingAlgorithm;
+        deleted->setGraph(dyGraph.getDiGraph());
+        dyGraph.onDefragment(deleted);
+        delete deleted;
+
+        std::mt19937 gen(seed);
+        for (auto i = 0U; i < 40U; i++) {
+            DynamicTime time = gen() % (dyGraph.getMaxTime() + 1U);
+            dyGraph.seekToTime(time);
+            const auto &vertices = expected[time].vertices;
+            VertexIdentifier id = vertices.empty() ? 0U : vertices[gen() % vertices.size()];
+            algorithm.tracked = dyGraph.vertexAt(id);
+
+            auto numChanges = algorithm.numChanges;
+            auto numRebuilds = algorithm.numRebuilds;
+            dyGraph.defragment();
+            CHECK(algorithm.numRebuilds == numRebuilds + 1U);
+            CHECK(!algorithm.rebuilding);
+            CHECK(algorithm.numChanges == numChanges);
+            CHECK(algorithm.tracked == dyGraph.vertexAt(id));
+            CHECK(dyGraph.getCurrentTime() == time);
+            CHECK(snapshotOf(dyGraph) == expected[time]);
+
+            // replay continues in both directions from the rebuilt graph
+            if (dyGraph.applyNextDelta()) {
+                CHECK(snapshotOf(dyGraph) == expected[dyGraph.getCurrentTime()]);
+                CHECK(algorithm.numChanges > numChanges);
+            }
+            if (dyGraph.applyPreviousDelta()) {
+                CHECK(snapshotOf(dyGraph) == expected[dyGraph.getCurrentTime()]);
+            }
+        }
+        dyGraph.removeOnDefragment(&algorithm);
+    }
+}
+
+}
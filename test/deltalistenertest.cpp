@@ -0,0 +1,216 @@
+/**
+ * Copyright (C) 2013 - 2019 : Kathrin Hanauer
+ *
+ * This file is part of Algora.
+ *
+ * Algora is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Algora is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Algora.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact information:
+ *   http://algora.xaikal.org
+ */
+
+#include "test.h"
+#include "randomlog.h"
+
+#include "algorithm/dynamicdigraphalgorithm.h"
+#include "graph.incidencelist/incidencelistgraph.h"
+
+#include <stdexcept>
+
+namespace Algora {
+
+// Keeps track of the size of the graph from the changes and rebuilds it is told about.
+class CountingAlgorithm : public DynamicDiGraphAlgorithm
+{
+public:
+    explicit CountingAlgorithm(bool atOnce) {
+        receiveDeltasAtOnce(atOnce);
+    }
+
+    DiGraph::size_type numVertices = 0U;
+    DiGraph::size_type numArcs = 0U;
+    unsigned int numDeltas = 0U;
+    unsigned int numRebuilds = 0U;
+
+    bool isUpToDate() const {
+        return numVertices == diGraph->getSize() && numArcs == diGraph->getNumArcs(true);
+    }
+
+    // DiGraphAlgorithm interface
+    virtual void run() override { }
+    virtual std::string getName() const noexcept override { return "Counting Algorithm"; }
+    virtual std::string getShortName() const noexcept override { return "Counting"; }
+
+    // DynamicDiGraphAlgorithm interface
+    virtual void onVertexAdd(Vertex *) override { numVertices++; }
+    virtual void onVertexRemove(Vertex *) override { numVertices--; }
+    virtual void onArcAdd(Arc *) override { numArcs++; }
+    virtual void onArcRemove(Arc *) override { numArcs--; }
+    virtual void onDelta(const std::vector<Arc*> &, const std::vector<Arc*> &removedArcs,
+                         const std::vector<Vertex*> &,
+                         const std::vector<Vertex*> &removedVertices) override {
+        // additions are applied already, removals are still contained in the graph
+        numDeltas++;
+        count();
+        numVertices -= removedVertices.size();
+        numArcs -= removedArcs.size();
+    }
+
+protected:
+    virtual void onDiGraphSet() override {
+        DynamicDiGraphAlgorithm::onDiGraphSet();
+        count();
+    }
+    virtual void onGraphRebuilt(const VertexRemapping &) override {
+        numRebuilds++;
+        count();
+    }
+
+private:
+    void count() {
+        numVertices = diGraph->getSize();
+        numArcs = diGraph->getNumArcs(true);
+    }
+};
+
+// Registers for arc additions only.
+class ArcAddAlgorithm : public DynamicDiGraphAlgorithm
+{
+public:
+    explicit ArcAddAlgorithm(bool atOnce) {
+        receiveDeltasAtOnce(atOnce);
+        registerEvents(false, false, true, false);
+    }
+
+    unsigned int numArcAdds = 0U;
+    unsigned int numOthers = 0U;
+
+    // DiGraphAlgorithm interface
+    virtual void run() override { }
+    virtual std::string getName() const noexcept override { return "Arc Addition Algorithm"; }
+    virtual std::string getShortName() const noexcept override { return "ArcAdd"; }
+
+    // DynamicDiGraphAlgorithm interface
+    virtual void onVertexAdd(Vertex *) override { numOthers++; }
+    virtual void onVertexRemove(Vertex *) override { numOthers++; }
+    virtual void onArcAdd(Arc *) override { numArcAdds++; }
+    virtual void onArcRemove(Arc *) override { numOthers++; }
+    virtual void onDelta(const std::vector<Arc*> &addedArcs, const std::vector<Arc*> &removedArcs,
+                         const std::vector<Vertex*> &addedVertices,
+                         const std::vector<Vertex*> &removedVertices) override {
+        numArcAdds += addedArcs.size();
+        numOthers += removedArcs.size() + addedVertices.size() + removedVertices.size();
+    }
+};
+
+static void checkRegisteredEvents(bool atOnce)
+{
+    DynamicDiGraph dyGraph;
+    generateRandomLog(dyGraph, 8U, 150U);
+    dyGraph.resetToBigBang();
+
+    ArcAddAlgorithm arcAdd(atOnce);
+    arcAdd.setGraph(dyGraph.getDiGraph());
+    dyGraph.onDelta(&arcAdd);
+    ArcAddAlgorithm observing(atOnce);
+    observing.setGraph(dyGraph.getDiGraph());
+    unsigned int numArcAdds = 0U;
+    dyGraph.getDiGraph()->onArcAdd(&numArcAdds, [&numArcAdds](Arc *) { numArcAdds++; });
+
+    while (dyGraph.applyNextDelta()) { }
+    CHECK(numArcAdds > 0U);
+    CHECK(arcAdd.numArcAdds == numArcAdds);
+    CHECK(arcAdd.numOthers == 0U);
+    CHECK(observing.numArcAdds == numArcAdds);
+    CHECK(observing.numOthers == 0U);
+
+    dyGraph.getDiGraph()->removeOnArcAdd(&numArcAdds);
+    dyGraph.removeOnDelta(&arcAdd);
+}
+
+static void checkListener(bool atOnce)
+{
+    DynamicDiGraph dyGraph;
+    generateRandomLog(dyGraph, 7U, 150U);
+    dyGraph.resetToBigBang();
+
+    CountingAlgorithm algorithm(atOnce);
+    algorithm.setGraph(dyGraph.getDiGraph());
+    dyGraph.onDelta(&algorithm);
+    dyGraph.onDefragment(&algorithm);
+
+    unsigned int numDeltas = 0U;
+    while (dyGraph.applyNextDelta()) {
+        numDeltas++;
+        CHECK(algorithm.isUpToDate());
+    }
+    CHECK(!atOnce || algorithm.numDeltas == numDeltas);
+
+    // undo, restoring checkpoints and bulk rebuilds
+    dyGraph.setCheckpointInterval(10U);
+    dyGraph.seekToTime(40U);
+    CHECK(algorithm.isUpToDate());
+    dyGraph.seekToTime(dyGraph.getMaxTime());
+    CHECK(algorithm.isUpToDate());
+    dyGraph.seekToTime(75U);
+    CHECK(algorithm.isUpToDate());
+    auto numRebuilds = algorithm.numRebuilds;
+    dyGraph.fastForwardToTime(120U);
+    CHECK(algorithm.isUpToDate());
+    CHECK(algorithm.numRebuilds > numRebuilds);
+    numRebuilds = algorithm.numRebuilds;
+    dyGraph.defragment();
+    CHECK(algorithm.isUpToDate());
+    CHECK(algorithm.numRebuilds > numRebuilds);
+    dyGraph.applyNextDelta();
+    CHECK(algorithm.isUpToDate());
+    dyGraph.resetToBigBang();
+    CHECK(algorithm.isUpToDate());
+
+    // an algorithm listens to one dynamic graph only
+    DynamicDiGraph other;
+    bool thrown = false;
+    try {
+        other.onDelta(&algorithm);
+    } catch (const std::logic_error &) {
+        thrown = true;
+    }
+    CHECK(thrown);
+
+    // deleted algorithms are not notified anymore
+    auto *deleted = new CountingAlgorithm(atOnce);
+    deleted->setGraph(dyGraph.getDiGraph());
+    dyGraph.onDelta(deleted);
+    dyGraph.onDefragment(deleted);
+    delete deleted;
+    while (dyGraph.applyNextDelta()) {
+        CHECK(algorithm.isUpToDate());
+    }
+    dyGraph.defragment();
+    dyGraph.seekToTime(20U);
+    CHECK(algorithm.isUpToDate());
+
+    dyGraph.removeOnDelta(&algorithm);
+    dyGraph.removeOnDefragment(&algorithm);
+}
+
+void testDeltaListeners()
+{
+    checkListener(false);
+    checkListener(true);
+    checkRegisteredEvents(false);
+    checkRegisteredEvents(true);
+}
+
+}
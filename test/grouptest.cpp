@@ -0,0 +1,180 @@
+/**
+ * Copyright (C) 2013 - 2019 : Kathrin Hanauer
+ *
+ * This file is part of Algora.
+ *
+ * Algora is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Algora is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Algora.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact information:
+ *   http://algora.xaikal.org
+ */
+
+
+#include "test.h"
+#include "randomlog.h"
+
+#include "algorithm/dynamicdigraphalgorithmgroup.h"
+#include "graph.incidencelist/incidencelistgraph.h"
+
+namespace Algora {
+
+// Keeps track of the size of the graph from the changes it is told about.
+class SizeAlgorithm : public DynamicDiGraphAlgorithm
+{
+public:
+    explicit SizeAlgorithm(bool atOnce) {
+        receiveDeltasAtOnce(atOnce);
+    }
+
+    DiGraph::size_type numVertices = 0U;
+    DiGraph::size_type numArcs = 0U;
+    unsigned int numDeltas = 0U;
+    unsigned int numRuns = 0U;
+
+    bool isUpToDate() const {
+        return numVertices == diGraph->getSize() && numArcs == diGraph->getNumArcs(true);
+    }
+
+    // DiGraphAlgorithm interface
+    virtual void run() override { numRuns++; }
+    virtual std::string getName() const noexcept override { return "Size Algorithm"; }
+    virtual std::string getShortName() const noexcept override { return "Size"; }
+
+    // DynamicDiGraphAlgorithm interface
+    virtual void onVertexAdd(Vertex *) override { numVertices++; }
+    virtual void onVertexRemove(Vertex *) override { numVertices--; }
+    virtual void onArcAdd(Arc *) override { numArcs++; }
+    virtual void onArcRemove(Arc *) override { numArcs--; }
+    virtual void onDelta(const std::vector<Arc*> &addedArcs, const std::vector<Arc*> &removedArcs,
+                         const std::vector<Vertex*> &addedVertices,
+                         const std::vector<Vertex*> &removedVertices) override {
+        numDeltas++;
+        numVertices += addedVertices.size() - removedVertices.size();
+        numArcs += addedArcs.size() - removedArcs.size();
+    }
+};
+
+// Overrides are bypassed when added to a group as SizeAlgorithm.
+class DerivedSizeAlgorithm : public SizeAlgorithm
+{
+public:
+    using SizeAlgorithm::SizeAlgorithm;
+    unsigned int numOverrideCalls = 0U;
+    virtual void onArcAdd(Arc *a) override { numOverrideCalls++; SizeAlgorithm::onArcAdd(a); }
+};
+
+// Registers for arc additions only, deltas are passed on by the default onDelta().
+class ArcAddCountingAlgorithm : public DynamicDiGraphAlgorithm
+{
+public:
+    explicit ArcAddCountingAlgorithm(bool atOnce) {
+        receiveDeltasAtOnce(atOnce);
+        registerEvents(false, false, true, false);
+    }
+
+    unsigned int numArcAdds = 0U;
+    unsigned int numOthers = 0U;
+
+    // DiGraphAlgorithm interface
+    virtual void run() override { }
+    virtual std::string getName() const noexcept override { return "Arc Addition Counting Algorithm"; }
+    virtual std::string getShortName() const noexcept override { return "ArcAddCounting"; }
+
+    // DynamicDiGraphAlgorithm interface
+    virtual void onVertexAdd(Vertex *) override { numOthers++; }
+    virtual void onVertexRemove(Vertex *) override { numOthers++; }
+    virtual void onArcAdd(Arc *) override { numArcAdds++; }
+    virtual void onArcRemove(Arc *) override { numOthers++; }
+};
+
+typedef DynamicDiGraphAlgorithmGroup<SizeAlgorithm, ArcAddCountingAlgorithm> Group;
+
+static void checkGroup(bool viaDynamicDiGraph, bool atOnce)
+{
+    DynamicDiGraph dyGraph;
+    generateRandomLog(dyGraph, 111U, 150U);
+    dyGraph.resetToBigBang();
+    auto *diGraph = dyGraph.getDiGraph();
+    unsigned int numArcAdds = 0U;
+    diGraph->onArcAdd(&numArcAdds, [&numArcAdds](Arc *) { numArcAdds++; });
+
+    SizeAlgorithm size(atOnce);
+    SizeAlgorithm batched(true);
+    DerivedSizeAlgorithm derived(atOnce);
+    SizeAlgorithm idle(atOnce);
+    ArcAddCountingAlgorithm arcAdd(atOnce);
+    SizeAlgorithm single(false);
+    Group group;
+    for (auto *alg : std::vector<SizeAlgorithm*>{ &size, &batched, &derived, &idle }) {
+        alg->setGraph(diGraph);
+        group.add(alg);
+    }
+    idle.setAutoUpdate(false);
+    arcAdd.setGraph(diGraph);
+    group.add(&arcAdd);
+    CHECK(group.doesReceiveDeltasAtOnce() == atOnce);
+    // the group only receives deltas at once if all members do
+    single.setGraph(diGraph);
+    group.add(&single);
+    CHECK(!group.doesReceiveDeltasAtOnce());
+    group.remove(&single);
+    CHECK(group.doesReceiveDeltasAtOnce() == atOnce);
+    CHECK(group.getSize() == 5U);
+
+    group.setGraph(diGraph);
+    if (viaDynamicDiGraph) {
+        dyGraph.onDelta(&group);
+    }
+    while (dyGraph.getCurrentTime() < 75U && dyGraph.applyNextDelta()) {
+        CHECK(size.isUpToDate());
+        CHECK(batched.isUpToDate());
+        CHECK(derived.isUpToDate());
+    }
+
+    // removed members are not told anymore
+    group.remove(&size);
+    CHECK(group.getSize() == 4U);
+    auto numVertices = size.numVertices;
+    auto numArcs = size.numArcs;
+    while (dyGraph.applyNextDelta()) {
+        CHECK(batched.isUpToDate());
+        CHECK(derived.isUpToDate());
+    }
+    CHECK(size.numVertices == numVertices && size.numArcs == numArcs);
+    CHECK(numArcAdds > 0U);
+    CHECK(derived.numOverrideCalls == 0U);
+    // deltas at once only come from a DynamicDiGraph
+    CHECK((batched.numDeltas > 0U) == (viaDynamicDiGraph && atOnce));
+    CHECK(idle.numVertices == 0U && idle.numArcs == 0U);
+    CHECK(arcAdd.numArcAdds == numArcAdds);
+    CHECK(arcAdd.numOthers == 0U);
+
+    group.run();
+    CHECK(batched.numRuns == 1U && idle.numRuns == 1U && size.numRuns == 0U);
+
+    if (viaDynamicDiGraph) {
+        dyGraph.removeOnDelta(&group);
+    }
+    diGraph->removeOnArcAdd(&numArcAdds);
+}
+
+void testAlgorithmGroup()
+{
+    checkGroup(false, false);
+    checkGroup(false, true);
+    checkGroup(true, false);
+    checkGroup(true, true);
+}
+
+}
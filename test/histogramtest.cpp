@@ -0,0 +1,94 @@
+/**
+ * Copyright (C) 2013 - 2019 : Kathrin Hanauer
+ *
+ * This file is part of Algora.
+ *
+ * Algora is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Algora is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Algora.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact information:
+ *   http://algora.xaikal.org
+ */
+
+
+#include "test.h"
+
+#include "profiling/loghistogram.h"
+#include "algorithm/dynamicdigraphalgorithm.h"
+#include "graph.incidencelist/incidencelistgraph.h"
+
+namespace Algora {
+
+// Does nothing but is timed.
+class IdleAlgorithm : public DynamicDiGraphAlgorithm
+{
+public:
+    // DiGraphAlgorithm interface
+    virtual void run() override { }
+    virtual std::string getName() const noexcept override { return "Idle Algorithm"; }
+    virtual std::string getShortName() const noexcept override { return "Idle"; }
+};
+
+void testLogHistogram()
+{
+    LogHistogram histogram;
+    CHECK(histogram.getCount() == 0U);
+    CHECK(histogram.getPercentile(0.5) == 0U);
+
+    for (LogHistogram::value_type value = 1U; value <= 1000U; value++) {
+        histogram.record(value);
+    }
+    histogram.record(1000000U);
+    CHECK(histogram.getCount() == 1001U);
+    CHECK(histogram.getMax() == 1000000U);
+
+    // exact for small values, within 1/16 above
+    CHECK(histogram.getPercentile(0.0) == 1U);
+    CHECK(histogram.getPercentile(0.01) == 11U);
+    auto median = histogram.getPercentile(0.5);
+    CHECK(median >= 501U && median <= 501U + 501U / 16U);
+    auto p99 = histogram.getPercentile(0.99);
+    CHECK(p99 >= 991U && p99 <= 991U + 991U / 16U);
+    CHECK(histogram.getPercentile(1.0) == 1000000U);
+
+    histogram.clear();
+    CHECK(histogram.getCount() == 0U);
+    CHECK(histogram.getMax() == 0U);
+
+    // single values across bucket boundaries
+    for (LogHistogram::value_type value = 0U; value < (1ULL << 40U); value = value * 3U / 2U + 1U) {
+        LogHistogram single;
+        single.record(value);
+        auto p = single.getPercentile(0.5);
+        CHECK(p >= value && p <= value + value / 16U);
+    }
+
+    // latencies of the changes passed on to an algorithm
+    IncidenceListGraph graph;
+    IdleAlgorithm algorithm;
+    algorithm.recordLatencies(true);
+    algorithm.setGraph(&graph);
+    Vertex *u = graph.addVertex();
+    Vertex *v = graph.addVertex();
+    for (auto i = 0U; i < 10U; i++) {
+        graph.addArc(u, v);
+    }
+    typedef DynamicDiGraphAlgorithm::Latency Latency;
+    CHECK(algorithm.getLatencies(Latency::VertexAdd).getCount() == 2U);
+    CHECK(algorithm.getLatencies(Latency::ArcAdd).getCount() == 10U);
+    CHECK(algorithm.getLatencies(Latency::ArcRemove).getCount() == 0U);
+    algorithm.recordLatencies(false);
+    CHECK(!algorithm.doesRecordLatencies());
+}
+
+}
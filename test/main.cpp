@@ -0,0 +1,92 @@
+/**
+ * Copyright (C) 2013 - 2019 : Kathrin Hanauer
+ *
+ * This file is part of Algora.
+ *
+ * Algora is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Algora is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Algora.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact information:
+ *   http://algora.xaikal.org
+ */
+
+#include "test.h"
+
+#include <iostream>
+#include <exception>
+#include <utility>
+#include <vector>
+
+namespace Algora {
+
+static unsigned int numFailures = 0U;
+
+void fail(const char *file, int line, const char *condition)
+{
+    numFailures++;
+    std::cerr << file << ":" << line << ": check failed: " << condition << std::endl;
+}
+
+unsigned int getNumberOfFailures()
+{
+    return numFailures;
+}
+
+}
+
+int main()
+{
+    using namespace Algora;
+
+    const std::vector<std::pair<const char*, void (*)()>> tests = {
+        { "replay", testReplay },
+        { "arc index", testArcIndex },
+        { "undo", testUndo },
+        { "seek", testSeek },
+        { "fast-forward", testFastForward },
+        { "lightweight construction", testLightweightConstruction },
+        { "vertex ids", testVertexIds },
+        { "dense vertex ids", testDenseVertexIds },
+        { "net deltas", testNetDeltas },
+        { "save and load", testSaveLoad },
+        { "online mode", testOnlineMode },
+        { "sliding window", testSlidingWindow },
+        { "shared log", testSharedLog },
+        { "fork", testFork },
+        { "temporal queries", testTemporalQueries },
+        { "defragment", testDefragment },
+        { "delta listeners", testDeltaListeners },
+        { "algorithm group", testAlgorithmGroup },
+        { "static algorithm wrapper", testStaticWrapper },
+        { "log histogram", testLogHistogram },
+        { "tracer", testTracer },
+    };
+
+    for (const auto &test : tests) {
+        auto failuresBefore = getNumberOfFailures();
+        try {
+            test.second();
+        } catch (const std::exception &e) {
+            fail(test.first, 0, e.what());
+        }
+        std::cout << test.first << ": "
+                  << (getNumberOfFailures() == failuresBefore ? "ok" : "FAILED") << std::endl;
+    }
+
+    if (getNumberOfFailures() > 0U) {
+        std::cerr << getNumberOfFailures() << " check(s) failed." << std::endl;
+        return 1;
+    }
+    std::cout << "All checks passed." << std::endl;
+    return 0;
+}
@@ -0,0 +1,74 @@
+/**
+ * Copyright (C) 2013 - 2019 : Kathrin Hanauer
+ *
+ * This file is part of Algora.
+ *
+ * Algora is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Algora is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Algora.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact information:
+ *   http://algora.xaikal.org
+ */
+
+#include "test.h"
+#include "randomlog.h"
+
+#include <stdexcept>
+#include <memory>
+
+namespace Algora {
+
+template<typename F>
+static bool throwsLogicError(const F &f)
+{
+    try {
+        f();
+    } catch (const std::logic_error &) {
+        return true;
+    }
+    return false;
+}
+
+void testOnlineMode()
+{
+    DynamicDiGraph dyGraph;
+    dyGraph.useOnlineMode(true);
+    RandomLogGenerator generator(51U);
+    for (DynamicTime t = 1U; t <= 300U; t++) {
+        generator.addDelta(dyGraph, t);
+        // operations are applied as soon as they are added
+        CHECK(snapshotOf(dyGraph) == generator.getSnapshot());
+        CHECK(dyGraph.getCurrentTime() == t);
+        CHECK(dyGraph.getNumberOfDeltas() <= 1U);
+    }
+    // there is no history to go back to
+    auto final = generator.getSnapshot();
+    dyGraph.resetToBigBang();
+    CHECK(snapshotOf(dyGraph) == final);
+    CHECK(!dyGraph.applyNextDelta());
+    CHECK(snapshotOf(dyGraph) == final);
+
+    // the log does not describe the current graph anymore
+    DynamicDiGraph online;
+    online.useOnlineMode(true);
+    online.addArc(1U, 2U, 1U);
+    online.addArc(2U, 3U, 2U);
+    online.removeArc(1U, 2U, 3U);
+    CHECK(online.getDiGraph()->getNumArcs(true) == 1U);
+    CHECK(throwsLogicError([&]() { online.saveLog("algoradyntest-online.bin"); }));
+    CHECK(throwsLogicError([&]() { std::unique_ptr<DynamicDiGraph> fork(online.fork()); }));
+    CHECK(throwsLogicError([&]() { DynamicDiGraph cursor; cursor.shareLogOf(online); }));
+    CHECK(throwsLogicError([&]() { online.wasArcPresentAt(2U, 3U, 2U); }));
+}
+
+}
@@ -0,0 +1,155 @@
+/**
+ * Copyright (C) 2013 - 2019 : Kathrin Hanauer
+ *
+ * This file is part of Algora.
+ *
+ * Algora is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Algora is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Algora.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact information:
+ *   http://algora.xaikal.org
+ */
+
+#include "randomlog.h"
+
+#include "graph.incidencelist/incidencelistgraph.h"
+#include "graph/arc.h"
+
+#include <algorithm>
+
+namespace Algora {
+
+bool Snapshot::hasArc(VertexIdentifier tailId, VertexIdentifier headId) const
+{
+    return std::binary_search(arcs.begin(), arcs.end(), ArcIds(tailId, headId));
+}
+
+RandomLogGenerator::RandomLogGenerator(unsigned int seed, VertexIdentifier idFactor)
+    : gen(seed), idFactor(idFactor), present(NUM_IDS, false)
+{
+}
+
+void RandomLogGenerator::addDelta(DynamicDiGraph &dyGraph, DynamicTime timestamp)
+{
+    auto numOps = 1U + random(6U);
+    for (auto i = 0U; i < numOps; i++) {
+        VertexIdentifier id = random(NUM_IDS);
+        switch (random(10U)) {
+        case 0:
+            if (present[id]) {
+                dyGraph.removeVertex(id * idFactor, timestamp);
+                present[id] = false;
+                arcs.erase(std::remove_if(arcs.begin(), arcs.end(), [id](const ArcIds &a) {
+                    return a.first == id || a.second == id;
+                }), arcs.end());
+            } else {
+                dyGraph.addVertex(id * idFactor, timestamp);
+                present[id] = true;
+            }
+            break;
+        case 1:
+        case 2:
+        case 3:
+            if (!arcs.empty()) {
+                removeArc(dyGraph, random(arcs.size()), timestamp);
+                break;
+            }
+            // fall through
+        case 4:
+            if (!arcs.empty()) {
+                // multi-arc, possibly removed again right away
+                auto a = arcs[random(arcs.size())];
+                addArc(dyGraph, a.first, a.second, timestamp);
+                if (random(2U) == 0U) {
+                    removeArc(dyGraph, arcs.size() - 1U, timestamp);
+                }
+                break;
+            }
+            // fall through
+        default:
+            addArc(dyGraph, id, random(NUM_IDS), timestamp);
+            break;
+        }
+    }
+}
+
+Snapshot RandomLogGenerator::getSnapshot() const
+{
+    Snapshot snapshot;
+    for (VertexIdentifier id = 0U; id < NUM_IDS; id++) {
+        if (present[id]) {
+            snapshot.vertices.push_back(id * idFactor);
+        }
+    }
+    for (const auto &a : arcs) {
+        snapshot.arcs.emplace_back(a.first * idFactor, a.second * idFactor);
+    }
+    std::sort(snapshot.arcs.begin(), snapshot.arcs.end());
+    return snapshot;
+}
+
+void RandomLogGenerator::addArc(DynamicDiGraph &dyGraph, VertexIdentifier tail,
+                                VertexIdentifier head, DynamicTime timestamp)
+{
+    dyGraph.addArc(tail * idFactor, head * idFactor, timestamp);
+    present[tail] = true;
+    present[head] = true;
+    arcs.emplace_back(tail, head);
+}
+
+void RandomLogGenerator::removeArc(DynamicDiGraph &dyGraph, std::size_t i, DynamicTime timestamp)
+{
+    dyGraph.removeArc(arcs[i].first * idFactor, arcs[i].second * idFactor, timestamp);
+    arcs[i] = arcs.back();
+    arcs.pop_back();
+}
+
+std::vector<Snapshot> generateRandomLog(DynamicDiGraph &dyGraph, unsigned int seed,
+                                        DynamicTime numDeltas, VertexIdentifier idFactor)
+{
+    RandomLogGenerator generator(seed, idFactor);
+    std::vector<Snapshot> expected(1U);
+    for (DynamicTime t = 1U; t <= numDeltas; t++) {
+        generator.addDelta(dyGraph, t);
+        expected.push_back(generator.getSnapshot());
+    }
+    return expected;
+}
+
+Snapshot snapshotOf(const DynamicDiGraph &dyGraph)
+{
+    Snapshot snapshot;
+    auto *diGraph = dyGraph.getDiGraph();
+    diGraph->mapVertices([&](Vertex *v) {
+        snapshot.vertices.push_back(dyGraph.idOf(v));
+    });
+    diGraph->mapArcs([&](Arc *a) {
+        snapshot.arcs.emplace_back(dyGraph.idOf(a->getTail()), dyGraph.idOf(a->getHead()));
+    });
+    std::sort(snapshot.vertices.begin(), snapshot.vertices.end());
+    std::sort(snapshot.arcs.begin(), snapshot.arcs.end());
+    return snapshot;
+}
+
+std::vector<Snapshot> replayDeltaByDelta(DynamicDiGraph &dyGraph)
+{
+    std::vector<Snapshot> snapshots(dyGraph.getMaxTime() + 1U);
+    dyGraph.resetToBigBang();
+    snapshots[0] = snapshotOf(dyGraph);
+    while (dyGraph.applyNextDelta()) {
+        snapshots[dyGraph.getCurrentTime()] = snapshotOf(dyGraph);
+    }
+    return snapshots;
+}
+
+}
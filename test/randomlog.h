@@ -0,0 +1,91 @@
+/**
+ * Copyright (C) 2013 - 2019 : Kathrin Hanauer
+ *
+ * This file is part of Algora.
+ *
+ * Algora is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Algora is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Algora.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact information:
+ *   http://algora.xaikal.org
+ */
+
+#ifndef RANDOMLOG_H
+#define RANDOMLOG_H
+
+#include "graph.dyn/dynamicdigraph.h"
+
+#include <vector>
+#include <utility>
+#include <random>
+
+namespace Algora {
+
+typedef DynamicDiGraph::VertexIdentifier VertexIdentifier;
+typedef DynamicDiGraph::DynamicTime DynamicTime;
+typedef std::pair<VertexIdentifier, VertexIdentifier> ArcIds;
+
+// Vertex ids and arcs as (tail id, head id) of a graph state, both sorted, so that
+// states reached in different ways compare equal regardless of internal order.
+struct Snapshot {
+    std::vector<VertexIdentifier> vertices;
+    std::vector<ArcIds> arcs;
+
+    bool operator==(const Snapshot &other) const {
+        return vertices == other.vertices && arcs == other.arcs;
+    }
+    bool operator!=(const Snapshot &other) const { return !(*this == other); }
+    bool hasArc(VertexIdentifier tailId, VertexIdentifier headId) const;
+};
+
+// Adds deltas of random valid operations to a dynamic graph, including multi-arcs,
+// loops, vertex removals with incident arcs and arcs that are added and removed again
+// within the same delta. The expected state is kept in a mirror of its own, independent
+// of the dynamic graph. Vertex ids are multiples of idFactor.
+class RandomLogGenerator
+{
+public:
+    static constexpr VertexIdentifier NUM_IDS = 40U;
+
+    explicit RandomLogGenerator(unsigned int seed, VertexIdentifier idFactor = 1U);
+
+    void addDelta(DynamicDiGraph &dyGraph, DynamicTime timestamp);
+    // state after all deltas added so far
+    Snapshot getSnapshot() const;
+
+private:
+    std::mt19937 gen;
+    VertexIdentifier idFactor;
+    std::vector<bool> present;
+    std::vector<ArcIds> arcs;
+
+    std::size_t random(std::size_t n) { return static_cast<std::size_t>(gen() % n); }
+    void addArc(DynamicDiGraph &dyGraph, VertexIdentifier tail, VertexIdentifier head,
+                DynamicTime timestamp);
+    void removeArc(DynamicDiGraph &dyGraph, std::size_t i, DynamicTime timestamp);
+};
+
+// Add numDeltas random deltas at times 1, ..., numDeltas and return the expected
+// states indexed by time, starting with the empty graph at time 0.
+std::vector<Snapshot> generateRandomLog(DynamicDiGraph &dyGraph, unsigned int seed,
+                                        DynamicTime numDeltas, VertexIdentifier idFactor = 1U);
+
+Snapshot snapshotOf(const DynamicDiGraph &dyGraph);
+
+// States after resetToBigBang() and after each delta applied one by one, indexed by
+// time; leaves dyGraph at its last delta.
+std::vector<Snapshot> replayDeltaByDelta(DynamicDiGraph &dyGraph);
+
+}
+
+#endif // RANDOMLOG_H
@@ -0,0 +1,205 @@
+/**
+ * Copyright (C) 2013 - 2019 : Kathrin Hanauer
+ *
+ * This file is part of Algora.
+ *
+ * Algora is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Algora is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Algora.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact information:
+ *   http://algora.xaikal.org
+ */
+
+#include "test.h"
+#include "randomlog.h"
+
+#include <random>
+#include <algorithm>
+
+namespace Algora {
+
+static constexpr DynamicTime NUM_DELTAS = 300U;
+static constexpr unsigned int NUM_SEEKS = 200U;
+static constexpr unsigned int SEEDS[] = { 1U, 2U, 3U };
+
+void testReplay()
+{
+    for (auto seed : SEEDS) {
+        DynamicDiGraph dyGraph;
+        auto expected = generateRandomLog(dyGraph, seed, NUM_DELTAS);
+        CHECK(dyGraph.getNumberOfDeltas() == NUM_DELTAS);
+        CHECK(dyGraph.getMaxTime() == NUM_DELTAS);
+
+        CHECK(replayDeltaByDelta(dyGraph) == expected);
+        CHECK(dyGraph.getCurrentTime() == NUM_DELTAS);
+        // replaying again yields the same states
+        CHECK(replayDeltaByDelta(dyGraph) == expected);
+    }
+}
+
+static void undo(DynamicDiGraph &dyGraph, const std::vector<Snapshot> &expected)
+{
+    dyGraph.seekToTime(dyGraph.getMaxTime());
+    while (dyGraph.applyPreviousDelta()) {
+        CHECK(snapshotOf(dyGraph) == expected[dyGraph.getCurrentTime()]);
+    }
+    CHECK(dyGraph.getCurrentTime() == 0U);
+    CHECK(snapshotOf(dyGraph) == expected[0]);
+}
+
+void testUndo()
+{
+    for (auto seed : SEEDS) {
+        DynamicDiGraph dyGraph;
+        auto expected = generateRandomLog(dyGraph, seed, NUM_DELTAS);
+        undo(dyGraph, expected);
+
+        // alternate between both directions
+        std::mt19937 gen(seed);
+        for (auto i = 0U; i < NUM_SEEKS * 5U; i++) {
+            if (gen() % 2U == 0U) {
+                dyGraph.applyNextDelta();
+            } else {
+                dyGraph.applyPreviousDelta();
+            }
+            CHECK(snapshotOf(dyGraph) == expected[dyGraph.getCurrentTime()]);
+        }
+    }
+}
+
+static void checkSeek(DynamicDiGraph &dyGraph, const std::vector<Snapshot> &expected,
+                      unsigned int seed, bool fastForward)
+{
+    std::mt19937 gen(seed);
+    for (auto i = 0U; i < NUM_SEEKS; i++) {
+        DynamicTime time = gen() % (dyGraph.getMaxTime() + 1U);
+        if (fastForward) {
+            dyGraph.fastForwardToTime(time);
+        } else {
+            dyGraph.seekToTime(time);
+        }
+        CHECK(dyGraph.getCurrentTime() == time);
+        CHECK(snapshotOf(dyGraph) == expected[time]);
+        // replay continues from the state reached
+        if (dyGraph.applyNextDelta()) {
+            CHECK(snapshotOf(dyGraph) == expected[dyGraph.getCurrentTime()]);
+        }
+    }
+}
+
+void testSeek()
+{
+    for (auto seed : SEEDS) {
+        DynamicDiGraph dyGraph;
+        auto expected = generateRandomLog(dyGraph, seed, NUM_DELTAS);
+        checkSeek(dyGraph, expected, seed, false);
+
+        dyGraph.setCheckpointInterval(16U);
+        CHECK(replayDeltaByDelta(dyGraph) == expected);
+        checkSeek(dyGraph, expected, seed + 100U, false);
+
+        // a small budget thins out the checkpoints
+        dyGraph.setCheckpointMemoryBudget(1024U);
+        CHECK(replayDeltaByDelta(dyGraph) == expected);
+        checkSeek(dyGraph, expected, seed + 200U, false);
+        dyGraph.clearCheckpoints();
+        checkSeek(dyGraph, expected, seed + 300U, false);
+    }
+}
+
+void testFastForward()
+{
+    for (auto seed : SEEDS) {
+        DynamicDiGraph dyGraph;
+        auto expected = generateRandomLog(dyGraph, seed, NUM_DELTAS);
+        checkSeek(dyGraph, expected, seed, true);
+        dyGraph.fastForwardToTime(0U);
+        CHECK(snapshotOf(dyGraph) == expected[0]);
+        dyGraph.fastForwardToTime(NUM_DELTAS);
+        CHECK(snapshotOf(dyGraph) == expected[NUM_DELTAS]);
+        // undo works after a fast-forward
+        while (dyGraph.applyPreviousDelta()) {
+            CHECK(snapshotOf(dyGraph) == expected[dyGraph.getCurrentTime()]);
+        }
+    }
+}
+
+void testVertexIds()
+{
+    DynamicDiGraph dyGraph;
+    auto expected = generateRandomLog(dyGraph, 4U, NUM_DELTAS);
+    std::mt19937 gen(4U);
+    for (auto i = 0U; i < NUM_SEEKS; i++) {
+        DynamicTime time = gen() % (NUM_DELTAS + 1U);
+        dyGraph.seekToTime(time);
+        const auto &present = expected[time].vertices;
+        for (VertexIdentifier id = 0U; id < RandomLogGenerator::NUM_IDS; id++) {
+            auto *v = dyGraph.vertexAt(id);
+            if (std::binary_search(present.begin(), present.end(), id)) {
+                CHECK(v != nullptr && dyGraph.idOf(v) == id);
+            } else {
+                CHECK(v == nullptr);
+            }
+        }
+        for (DiGraph::size_type j = 0U; j < present.size(); j++) {
+            CHECK(std::binary_search(present.begin(), present.end(), dyGraph.idOfIthVertex(j)));
+        }
+    }
+}
+
+void testNetDeltas()
+{
+    for (auto seed : SEEDS) {
+        DynamicDiGraph dyGraph;
+        RandomLogGenerator generator(seed);
+        std::vector<Snapshot> expected(1U);
+        for (DynamicTime t = 1U; t <= NUM_DELTAS; t++) {
+            generator.addDelta(dyGraph, t);
+            expected.push_back(generator.getSnapshot());
+        }
+
+        // canonicalized on demand
+        dyGraph.resetToBigBang();
+        dyGraph.replayNetDeltas(true);
+        CHECK(replayDeltaByDelta(dyGraph) == expected);
+        checkSeek(dyGraph, expected, seed, false);
+
+        // the final delta grows after it has been canonicalized
+        for (auto i = 0U; i < 3U; i++) {
+            generator.addDelta(dyGraph, NUM_DELTAS);
+            expected.back() = generator.getSnapshot();
+            CHECK(replayDeltaByDelta(dyGraph) == expected);
+        }
+        generator.addDelta(dyGraph, NUM_DELTAS + 1U);
+        expected.push_back(generator.getSnapshot());
+        dyGraph.canonicalizeDeltas();
+        CHECK(replayDeltaByDelta(dyGraph) == expected);
+        generator.addDelta(dyGraph, NUM_DELTAS + 1U);
+        expected.back() = generator.getSnapshot();
+        // the grown delta is partially applied now
+        dyGraph.resetToBigBang();
+        dyGraph.canonicalizeDeltas();
+        CHECK(replayDeltaByDelta(dyGraph) == expected);
+
+        dyGraph.setCheckpointInterval(16U);
+        CHECK(replayDeltaByDelta(dyGraph) == expected);
+        checkSeek(dyGraph, expected, seed + 100U, false);
+        undo(dyGraph, expected);
+
+        dyGraph.resetToBigBang();
+        dyGraph.replayNetDeltas(false);
+        CHECK(replayDeltaByDelta(dyGraph) == expected);
+    }
+}
+
+}
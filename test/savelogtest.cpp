@@ -0,0 +1,148 @@
+/**
+ * Copyright (C) 2013 - 2019 : Kathrin Hanauer
+ *
+ * This file is part of Algora.
+ *
+ * Algora is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Algora is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Algora.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact information:
+ *   http://algora.xaikal.org
+ */
+
+#include "test.h"
+#include "randomlog.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <stdexcept>
+
+namespace Algora {
+
+static std::string readFile(const std::string &fileName)
+{
+    std::ifstream in(fileName, std::ios::binary);
+    std::stringstream content;
+    content << in.rdbuf();
+    return content.str();
+}
+
+static void writeFile(const std::string &fileName, const std::string &content)
+{
+    std::ofstream out(fileName, std::ios::binary | std::ios::trunc);
+    out.write(content.data(), static_cast<std::streamsize>(content.size()));
+}
+
+// Load a log and replay it in all directions; returns false if it is rejected.
+static bool loadAndReplay(const std::string &fileName, bool mapFile)
+{
+    DynamicDiGraph dyGraph;
+    try {
+        dyGraph.loadLog(fileName, mapFile);
+    } catch (const std::runtime_error &) {
+        return false;
+    }
+    while (dyGraph.applyNextDelta()) {
+        snapshotOf(dyGraph);
+    }
+    while (dyGraph.applyPreviousDelta()) { }
+    dyGraph.fastForwardToTime(dyGraph.getMaxTime() / 2U);
+    snapshotOf(dyGraph);
+    dyGraph.addArc(0U, 1U, dyGraph.getMaxTime());
+    dyGraph.seekToTime(dyGraph.getMaxTime());
+    snapshotOf(dyGraph);
+    return true;
+}
+
+void testSaveLoad()
+{
+    const std::string fileName = "algoradyntest-log.bin";
+    const std::string copyName = "algoradyntest-log-copy.bin";
+
+    DynamicDiGraph original;
+    auto expected = generateRandomLog(original, 42U, 200U);
+    original.seekToTime(100U);
+    original.saveLog(fileName);
+
+    for (auto mapFile : { false, true }) {
+        DynamicDiGraph loaded;
+        loaded.loadLog(fileName, mapFile);
+        CHECK(loaded.getNumberOfDeltas() == original.getNumberOfDeltas());
+        CHECK(loaded.getTimestamps() == original.getTimestamps());
+        CHECK(replayDeltaByDelta(loaded) == expected);
+
+        loaded.setCheckpointInterval(8U);
+        for (DynamicTime time : { 150U, 3U, 200U, 77U, 0U }) {
+            loaded.seekToTime(time);
+            CHECK(snapshotOf(loaded) == expected[time]);
+        }
+
+        // saving what was loaded writes the same file again
+        loaded.saveLog(copyName);
+        CHECK(readFile(copyName) == readFile(fileName));
+
+        // a loaded log can be extended
+        loaded.addVertex(1000U, loaded.getMaxTime() + 1U);
+        loaded.addArc(1000U, 1001U, loaded.getMaxTime());
+        loaded.seekToTime(loaded.getMaxTime());
+        auto extended = expected.back();
+        extended.vertices.push_back(1000U);
+        extended.vertices.push_back(1001U);
+        extended.arcs.emplace_back(1000U, 1001U);
+        std::sort(extended.arcs.begin(), extended.arcs.end());
+        CHECK(snapshotOf(loaded) == extended);
+        loaded.seekToTime(200U);
+        CHECK(snapshotOf(loaded) == expected[200U]);
+    }
+
+    // the original is not affected by the files
+    CHECK(replayDeltaByDelta(original) == expected);
+
+    // truncated and foreign files are rejected
+    auto content = readFile(fileName);
+    writeFile(copyName, content.substr(0U, content.size() / 2U));
+    CHECK(!loadAndReplay(copyName, false));
+    writeFile(copyName, "not a log");
+    CHECK(!loadAndReplay(copyName, false));
+
+    // corrupt files are rejected or at least replayed safely
+    DynamicDiGraph small;
+    generateRandomLog(small, 43U, 20U);
+    small.saveLog(fileName);
+    content = readFile(fileName);
+    for (std::size_t pos = 0U; pos + sizeof(std::uint64_t) <= content.size(); pos += sizeof(std::uint64_t)) {
+        for (std::uint64_t value : { 1000000ULL, ~0ULL }) {
+            auto corrupt = content;
+            std::memcpy(&corrupt[pos], &value, sizeof(value));
+            writeFile(copyName, corrupt);
+            loadAndReplay(copyName, pos % 64U == 0U);
+        }
+    }
+    for (std::size_t pos = 0U; pos < content.size(); pos++) {
+        for (char value : { '\x01', '\x03', '\x0F' }) {
+            auto corrupt = content;
+            corrupt[pos] = value;
+            writeFile(copyName, corrupt);
+            loadAndReplay(copyName, false);
+        }
+    }
+
+    std::remove(fileName.c_str());
+    std::remove(copyName.c_str());
+}
+
+}
@@ -0,0 +1,124 @@
+/**
+ * Copyright (C) 2013 - 2019 : Kathrin Hanauer
+ *
+ * This file is part of Algora.
+ *
+ * Algora is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Algora is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Algora.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact information:
+ *   http://algora.xaikal.org
+ */
+
+
+#include "test.h"
+#include "randomlog.h"
+
+#include <random>
+#include <memory>
+
+namespace Algora {
+
+static constexpr DynamicTime NUM_SHARED_DELTAS = 200U;
+
+void testSharedLog()
+{
+    for (auto seed : { 71U, 72U }) {
+        DynamicDiGraph dyGraph;
+        RandomLogGenerator generator(seed);
+        std::vector<Snapshot> expected(1U);
+        for (DynamicTime t = 1U; t <= NUM_SHARED_DELTAS; t++) {
+            generator.addDelta(dyGraph, t);
+            expected.push_back(generator.getSnapshot());
+        }
+        dyGraph.canonicalizeDeltas();
+
+        // cursors replay the shared log independently of each other and of the original
+        DynamicDiGraph plain;
+        plain.shareLogOf(dyGraph);
+        DynamicDiGraph net;
+        net.shareLogOf(dyGraph);
+        net.replayNetDeltas(true);
+        CHECK(net.getMaxTime() == NUM_SHARED_DELTAS);
+        std::mt19937 gen(seed);
+        for (auto i = 0U; i < 400U; i++) {
+            auto &cursor = gen() % 2U == 0U ? plain : net;
+            if (gen() % 3U == 0U) {
+                cursor.seekToTime(gen() % (NUM_SHARED_DELTAS + 1U));
+            } else {
+                cursor.applyNextDelta();
+            }
+            CHECK(snapshotOf(cursor) == expected[cursor.getCurrentTime()]);
+        }
+        CHECK(replayDeltaByDelta(net) == expected);
+        CHECK(dyGraph.getCurrentTime() == 0U);
+
+        // the final delta of the original grows after the cursors have shared its log
+        auto shared = expected;
+        generator.addDelta(dyGraph, NUM_SHARED_DELTAS);
+        expected.back() = generator.getSnapshot();
+        generator.addDelta(dyGraph, NUM_SHARED_DELTAS + 1U);
+        expected.push_back(generator.getSnapshot());
+        CHECK(replayDeltaByDelta(plain) == shared);
+        CHECK(replayDeltaByDelta(net) == shared);
+        dyGraph.replayNetDeltas(true);
+        CHECK(replayDeltaByDelta(dyGraph) == expected);
+
+        // a cursor that adds operations leaves the original alone
+        net.shareLogOf(dyGraph);
+        net.replayNetDeltas(true);
+        auto extended = expected;
+        RandomLogGenerator copy(generator);
+        copy.addDelta(net, NUM_SHARED_DELTAS + 2U);
+        extended.push_back(copy.getSnapshot());
+        CHECK(replayDeltaByDelta(net) == extended);
+        CHECK(replayDeltaByDelta(dyGraph) == expected);
+    }
+}
+
+void testFork()
+{
+    for (auto seed : { 81U, 82U }) {
+        DynamicDiGraph dyGraph;
+        auto expected = generateRandomLog(dyGraph, seed, NUM_SHARED_DELTAS);
+        std::mt19937 gen(seed);
+        for (auto i = 0U; i < 20U; i++) {
+            DynamicTime time = gen() % (NUM_SHARED_DELTAS + 1U);
+            dyGraph.seekToTime(time);
+            std::unique_ptr<DynamicDiGraph> fork(dyGraph.fork());
+            CHECK(fork->getCurrentTime() == time);
+            CHECK(snapshotOf(*fork) == expected[time]);
+
+            // replaying or rewinding the fork leaves the original untouched
+            while (fork->applyNextDelta()) {
+                CHECK(snapshotOf(*fork) == expected[fork->getCurrentTime()]);
+            }
+            fork->seekToTime(time);
+            CHECK(snapshotOf(*fork) == expected[time]);
+            fork->resetToBigBang();
+            CHECK(snapshotOf(*fork) == expected[0]);
+            CHECK(dyGraph.getCurrentTime() == time);
+            CHECK(snapshotOf(dyGraph) == expected[time]);
+        }
+
+        // a fork that adds operations leaves the original alone
+        dyGraph.seekToTime(NUM_SHARED_DELTAS);
+        std::unique_ptr<DynamicDiGraph> fork(dyGraph.fork());
+        fork->addVertex(RandomLogGenerator::NUM_IDS, NUM_SHARED_DELTAS + 1U);
+        CHECK(fork->getMaxTime() == NUM_SHARED_DELTAS + 1U);
+        CHECK(dyGraph.getMaxTime() == NUM_SHARED_DELTAS);
+        CHECK(replayDeltaByDelta(dyGraph) == expected);
+    }
+}
+
+}
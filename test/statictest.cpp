@@ -0,0 +1,143 @@
+/**
+ * Copyright (C) 2013 - 2019 : Kathrin Hanauer
+ *
+ * This file is part of Algora.
+ *
+ * Algora is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Algora is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Algora.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact information:
+ *   http://algora.xaikal.org
+ */
+
+
+#include "test.h"
+
+#include "algorithm/staticalgorithmwrapper.h"
+#include "graph.incidencelist/incidencelistgraph.h"
+
+#include <chrono>
+
+namespace Algora {
+
+// Counts the arcs of the graph whenever run.
+class ArcCountingAlgorithm : public DiGraphAlgorithm
+{
+public:
+    DiGraph::size_type numArcs = 0U;
+    unsigned int numPrepares = 0U;
+    unsigned int numRuns = 0U;
+
+    // DiGraphAlgorithm interface
+    virtual bool prepare() override { numPrepares++; return DiGraphAlgorithm::prepare(); }
+    virtual void run() override { numRuns++; numArcs = diGraph->getNumArcs(true); }
+    virtual std::string getName() const noexcept override { return "Arc Counting Algorithm"; }
+    virtual std::string getShortName() const noexcept override { return "ArcCounting"; }
+};
+
+// The wrapper owns the wrapped algorithm.
+static ArcCountingAlgorithm *setUp(StaticAlgorithmWrapper *&wrapper, IncidenceListGraph &graph,
+                                   StaticAlgorithmWrapper::RerunPolicy policy)
+{
+    auto *counting = new ArcCountingAlgorithm;
+    // vertex changes do not require a rerun
+    wrapper = new StaticAlgorithmWrapper(counting, false, false, true, true);
+    wrapper->setRerunPolicy(policy);
+    wrapper->setGraph(&graph);
+    wrapper->prepare();
+    wrapper->run();
+    return counting;
+}
+
+void testStaticWrapper()
+{
+    typedef StaticAlgorithmWrapper::RerunPolicy Policy;
+    StaticAlgorithmWrapper *wrapper;
+
+    {
+        IncidenceListGraph graph;
+        auto *counting = setUp(wrapper, graph, Policy::Eager);
+        Vertex *u = graph.addVertex();
+        Vertex *v = graph.addVertex();
+        CHECK(counting->numRuns == 1U);
+        Arc *a = graph.addArc(u, v);
+        graph.addArc(v, u);
+        CHECK(counting->numRuns == 3U && counting->numArcs == 2U);
+        // observers are told before the arc is gone
+        graph.removeArc(a);
+        CHECK(counting->numRuns == 4U);
+        CHECK(!wrapper->isOutdated());
+        // every run is prepared, in addition to the initial prepare() of the wrapper
+        CHECK(counting->numPrepares == counting->numRuns + 1U);
+        delete wrapper;
+    }
+    {
+        IncidenceListGraph graph;
+        auto *counting = setUp(wrapper, graph, Policy::OnAccess);
+        Vertex *u = graph.addVertex();
+        for (auto i = 0U; i < 5U; i++) {
+            graph.addArc(u, u);
+        }
+        CHECK(counting->numRuns == 1U && wrapper->isOutdated());
+        CHECK(wrapper->getAlgorithm() == counting);
+        CHECK(counting->numRuns == 2U && counting->numArcs == 5U);
+        CHECK(!wrapper->isOutdated());
+        wrapper->getAlgorithm();
+        CHECK(counting->numRuns == 2U);
+        // switching to eager catches up at once
+        graph.addArc(u, u);
+        wrapper->setRerunPolicy(Policy::Eager);
+        CHECK(counting->numRuns == 3U && counting->numArcs == 6U);
+        delete wrapper;
+    }
+    {
+        IncidenceListGraph graph;
+        auto *counting = setUp(wrapper, graph, Policy::EveryKUpdates);
+        wrapper->setRerunInterval(3U);
+        Vertex *u = graph.addVertex();
+        for (auto i = 1U; i <= 9U; i++) {
+            graph.addArc(u, u);
+            CHECK(counting->numRuns == 1U + i / 3U);
+            CHECK(wrapper->isOutdated() == (i % 3U != 0U));
+        }
+        // an explicit run starts counting anew
+        graph.addArc(u, u);
+        graph.addArc(u, u);
+        wrapper->run();
+        CHECK(counting->numRuns == 5U && counting->numArcs == 11U);
+        CHECK(!wrapper->isOutdated());
+        graph.addArc(u, u);
+        graph.addArc(u, u);
+        CHECK(counting->numRuns == 5U && wrapper->isOutdated());
+        graph.addArc(u, u);
+        CHECK(counting->numRuns == 6U && counting->numArcs == 14U);
+        CHECK(counting->numPrepares == counting->numRuns + 1U);
+        delete wrapper;
+    }
+    {
+        IncidenceListGraph graph;
+        auto *counting = setUp(wrapper, graph, Policy::TimeBudget);
+        wrapper->setRerunTimeBudget(std::chrono::hours(1));
+        Vertex *u = graph.addVertex();
+        graph.addArc(u, u);
+        graph.addArc(u, u);
+        CHECK(counting->numRuns == 1U && wrapper->isOutdated());
+        wrapper->setRerunTimeBudget(std::chrono::microseconds(0));
+        graph.addArc(u, u);
+        CHECK(counting->numRuns == 2U && counting->numArcs == 3U);
+        CHECK(!wrapper->isOutdated());
+        delete wrapper;
+    }
+}
+
+}
@@ -0,0 +1,99 @@
+/**
+ * Copyright (C) 2013 - 2019 : Kathrin Hanauer
+ *
+ * This file is part of Algora.
+ *
+ * Algora is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Algora is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Algora.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact information:
+ *   http://algora.xaikal.org
+ */
+
+
+#include "test.h"
+#include "randomlog.h"
+
+#include <algorithm>
+#include <random>
+
+namespace Algora {
+
+static constexpr DynamicTime TIME_STEP = 3U;
+
+static std::vector<VertexIdentifier> sorted(std::vector<VertexIdentifier> ids)
+{
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+static void checkStateAt(const DynamicDiGraph &dyGraph, const Snapshot &state, DynamicTime time)
+{
+    for (VertexIdentifier v = 0U; v < RandomLogGenerator::NUM_IDS; v++) {
+        std::vector<VertexIdentifier> out;
+        std::vector<VertexIdentifier> in;
+        for (const auto &a : state.arcs) {
+            if (a.first == v && (out.empty() || out.back() != a.second)) {
+                out.push_back(a.second);
+            }
+            if (a.second == v) {
+                in.push_back(a.first);
+            }
+        }
+        in.erase(std::unique(in.begin(), in.end()), in.end());
+        CHECK(sorted(dyGraph.getOutNeighborsAt(v, time)) == out);
+        CHECK(sorted(dyGraph.getInNeighborsAt(v, time)) == in);
+        for (VertexIdentifier w = 0U; w < RandomLogGenerator::NUM_IDS; w++) {
+            CHECK(dyGraph.wasArcPresentAt(v, w, time) == state.hasArc(v, w));
+        }
+    }
+}
+
+void testTemporalQueries()
+{
+    for (auto seed : { 91U, 92U }) {
+        // deltas at times 3, 6, ...; in between, the state of the previous delta holds
+        DynamicDiGraph dyGraph;
+        RandomLogGenerator generator(seed);
+        std::vector<Snapshot> expected(1U);
+        for (DynamicTime t = 1U; t <= 100U; t++) {
+            generator.addDelta(dyGraph, t * TIME_STEP);
+            expected.push_back(generator.getSnapshot());
+        }
+        auto stateAt = [&expected](DynamicTime time) {
+            return expected[std::min<DynamicTime>(time / TIME_STEP, expected.size() - 1U)];
+        };
+
+        std::mt19937 gen(seed);
+        for (auto i = 0U; i < 60U; i++) {
+            DynamicTime time = gen() % (dyGraph.getMaxTime() + 2U * TIME_STEP);
+            checkStateAt(dyGraph, stateAt(time), time);
+        }
+        // queries do not touch the current graph
+        CHECK(dyGraph.getCurrentTime() == 0U);
+        CHECK(snapshotOf(dyGraph) == expected[0]);
+
+        // the index follows the log as it grows
+        for (auto i = 0U; i < 3U; i++) {
+            generator.addDelta(dyGraph, dyGraph.getMaxTime());
+            expected.back() = generator.getSnapshot();
+            checkStateAt(dyGraph, expected.back(), dyGraph.getMaxTime());
+            generator.addDelta(dyGraph, dyGraph.getMaxTime() + TIME_STEP);
+            expected.push_back(generator.getSnapshot());
+            checkStateAt(dyGraph, expected.back(), dyGraph.getMaxTime());
+            checkStateAt(dyGraph, expected[expected.size() - 2U], dyGraph.getMaxTime() - 1U);
+        }
+    }
+}
+
+}
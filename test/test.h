@@ -0,0 +1,59 @@
+/**
+ * Copyright (C) 2013 - 2019 : Kathrin Hanauer
+ *
+ * This file is part of Algora.
+ *
+ * Algora is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Algora is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Algora.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact information:
+ *   http://algora.xaikal.org
+ */
+
+#ifndef ALGORADYNTEST_H
+#define ALGORADYNTEST_H
+
+namespace Algora {
+
+// Record a failed check; tests continue after failures.
+void fail(const char *file, int line, const char *condition);
+unsigned int getNumberOfFailures();
+
+void testReplay();
+void testArcIndex();
+void testUndo();
+void testSeek();
+void testFastForward();
+void testLightweightConstruction();
+void testVertexIds();
+void testDenseVertexIds();
+void testNetDeltas();
+void testSaveLoad();
+void testOnlineMode();
+void testSlidingWindow();
+void testSharedLog();
+void testFork();
+void testTemporalQueries();
+void testDefragment();
+void testDeltaListeners();
+void testAlgorithmGroup();
+void testStaticWrapper();
+void testLogHistogram();
+void testTracer();
+
+}
+
+#define CHECK(condition) \
+    do { if (!(condition)) { Algora::fail(__FILE__, __LINE__, #condition); } } while (false)
+
+#endif // ALGORADYNTEST_H
@@ -0,0 +1,112 @@
+/**
+ * Copyright (C) 2013 - 2019 : Kathrin Hanauer
+ *
+ * This file is part of Algora.
+ *
+ * Algora is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Algora is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Algora.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact information:
+ *   http://algora.xaikal.org
+ */
+
+
+#include "test.h"
+
+#include "profiling/tracer.h"
+
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <thread>
+#include <atomic>
+#include <vector>
+
+namespace Algora {
+
+static std::string writtenTrace()
+{
+    const std::string fileName = "algoradyntest-trace.json";
+    Tracer::writeJson(fileName);
+    std::ifstream in(fileName);
+    std::stringstream content;
+    content << in.rdbuf();
+    std::remove(fileName.c_str());
+    return content.str();
+}
+
+void testTracer()
+{
+    Tracer::clear();
+    Tracer::enable(true);
+    {
+        Tracer::Scope scope("testScope", "test");
+        scope.arg("answer", 42);
+    }
+    Tracer::enable(false);
+    {
+        // not recorded
+        Tracer::Scope scope("disabledScope", "test");
+    }
+    auto json = writtenTrace();
+    CHECK(json.find("\"traceEvents\"") != std::string::npos);
+    CHECK(json.find("\"name\":\"testScope\"") != std::string::npos);
+    CHECK(json.find("\"answer\":42") != std::string::npos);
+    CHECK(json.find("disabledScope") == std::string::npos);
+    // timestamps are written in fixed notation
+    CHECK(json.find("e+") == std::string::npos);
+    CHECK(json.find("e-") == std::string::npos);
+
+    // a thread keeps its most recent events only
+    Tracer::clear();
+    Tracer::setBufferCapacity(4U);
+    Tracer::enable(true);
+    std::thread([]() {
+        for (Tracer::arg_type i = 0; i < 10; i++) {
+            Tracer::Scope scope("ringScope", "test");
+            scope.arg("index", i);
+        }
+    }).join();
+    Tracer::enable(false);
+    Tracer::setBufferCapacity(1U << 16);
+    json = writtenTrace();
+    CHECK(json.find("\"index\":5") == std::string::npos);
+    for (auto i : { 6, 7, 8, 9 }) {
+        CHECK(json.find("\"index\":" + std::to_string(i)) != std::string::npos);
+    }
+    Tracer::clear();
+    CHECK(writtenTrace().find("ringScope") == std::string::npos);
+
+    // clearing while threads record
+    Tracer::enable(true);
+    std::atomic<bool> stop(false);
+    std::vector<std::thread> threads;
+    for (auto t = 0U; t < 2U; t++) {
+        threads.emplace_back([&stop]() {
+            while (!stop.load()) {
+                Tracer::Scope scope("raceScope", "test");
+            }
+        });
+    }
+    for (auto i = 0U; i < 1000U; i++) {
+        Tracer::clear();
+    }
+    stop = true;
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    Tracer::enable(false);
+    Tracer::clear();
+}
+
+}
@@ -0,0 +1,221 @@
+/**
+ * Copyright (C) 2013 - 2019 : Kathrin Hanauer
+ *
+ * This file is part of Algora.
+ *
+ * Algora is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Algora is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Algora.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Contact information:
+ *   http://algora.xaikal.org
+ */
+
+
+#include "test.h"
+#include "randomlog.h"
+
+#include <algorithm>
+#include <random>
+
+namespace Algora {
+
+static const DynamicTime WINDOW = 6U;
+
+// Mirror of a log with a sliding window: arcs stay until removed explicitly, but are
+// only present until their addition time plus the window. Removals pick the oldest
+// arc that has not expired.
+struct WindowMirror {
+    struct Instance {
+        VertexIdentifier tail;
+        VertexIdentifier head;
+        DynamicTime added;
+    };
+    std::vector<bool> present;
+    std::vector<Instance> arcs;
+
+    explicit WindowMirror(VertexIdentifier numIds) : present(numIds, false) { }
+
+    bool isLive(const Instance &a, DynamicTime t) const { return a.added + WINDOW > t; }
+
+    bool hasLiveArc(VertexIdentifier tail, VertexIdentifier head, DynamicTime t) const {
+        return std::any_of(arcs.begin(), arcs.end(), [&](const Instance &a) {
+            return a.tail == tail && a.head == head && isLive(a, t);
+        });
+    }
+
+    bool isIsolatedAt(VertexIdentifier id, DynamicTime t) const {
+        return std::none_of(arcs.begin(), arcs.end(), [&](const Instance &a) {
+            return (a.tail == id || a.head == id) && isLive(a, t);
+        });
+    }
+
+    void removeVertex(VertexIdentifier id) {
+        present[id] = false;
+        arcs.erase(std::remove_if(arcs.begin(), arcs.end(), [id](const Instance &a) {
+            return a.tail == id || a.head == id;
+        }), arcs.end());
+    }
+
+    void removeArc(VertexIdentifier tail, VertexIdentifier head, DynamicTime t,
+                   bool removeIsolatedEnds) {
+        auto chosen = arcs.end();
+        for (auto i = arcs.begin(); i != arcs.end(); i++) {
+            if (i->tail != tail || i->head != head) {
+                continue;
+            }
+            if (chosen == arcs.end() || (!isLive(*chosen, t) && isLive(*i, t))
+                    || (isLive(*i, t) && i->added < chosen->added)) {
+                chosen = i;
+            }
+        }
+        arcs.erase(chosen);
+        if (removeIsolatedEnds) {
+            bool removeTail = isIsolatedAt(tail, t);
+            bool removeHead = tail != head && isIsolatedAt(head, t);
+            if (removeTail) {
+                removeVertex(tail);
+            }
+            if (removeHead) {
+                removeVertex(head);
+            }
+        }
+    }
+
+    Snapshot snapshotAt(DynamicTime t) const {
+        Snapshot snapshot;
+        for (VertexIdentifier id = 0U; id < present.size(); id++) {
+            if (present[id]) {
+                snapshot.vertices.push_back(id);
+            }
+        }
+        for (const auto &a : arcs) {
+            if (isLive(a, t)) {
+                snapshot.arcs.emplace_back(a.tail, a.head);
+            }
+        }
+        std::sort(snapshot.arcs.begin(), snapshot.arcs.end());
+        return snapshot;
+    }
+};
+
+static void checkWindowedLog(DynamicDiGraph &dyGraph, const std::vector<Snapshot> &expected)
+{
+    auto replayed = replayDeltaByDelta(dyGraph);
+    CHECK(replayed.size() == expected.size());
+    for (DynamicTime t = 0U; t < std::min(replayed.size(), expected.size()); t++) {
+        CHECK(replayed[t] == expected[t]);
+        for (const auto &a : expected[t].arcs) {
+            CHECK(dyGraph.wasArcPresentAt(a.first, a.second, t));
+        }
+    }
+}
+
+static void testReviewScenarios()
+{
+    // the removal applies to the arc added at time 5, the one of time 1 has expired
+    DynamicDiGraph dyGraph;
+    dyGraph.setSlidingWindow(WINDOW);
+    dyGraph.addArc(0U, 1U, 1U);
+    dyGraph.addArc(0U, 1U, 5U);
+    CHECK(dyGraph.getConstructedArcSize() == 2U);
+    dyGraph.removeArc(0U, 1U, 8U);
+    dyGraph.noop(9U);
+    CHECK(!dyGraph.hasArc(0U, 1U));
+    CHECK(dyGraph.getConstructedArcSize() == 0U);
+    CHECK(dyGraph.wasArcPresentAt(0U, 1U, 7U));
+    CHECK(!dyGraph.wasArcPresentAt(0U, 1U, 8U));
+    CHECK(!dyGraph.wasArcPresentAt(0U, 1U, 9U));
+    auto replayed = replayDeltaByDelta(dyGraph);
+    CHECK(replayed[5].arcs.size() == 2U);
+    CHECK(replayed[8].arcs.empty());
+    CHECK(replayed[9].arcs.empty());
+
+    // re-adding an expired arc adds it again
+    DynamicDiGraph sir;
+    sir.setSlidingWindow(WINDOW);
+    sir.secondArcIsRemoval(true);
+    sir.addArc(0U, 1U, 1U);
+    sir.addArc(0U, 1U, 8U);
+    CHECK(sir.hasArc(0U, 1U));
+    CHECK(sir.getConstructedArcSize() == 1U);
+    CHECK(sir.wasArcPresentAt(0U, 1U, 8U));
+    sir.addArc(0U, 1U, 9U);
+    CHECK(!sir.hasArc(0U, 1U));
+    CHECK(!sir.wasArcPresentAt(0U, 1U, 9U));
+
+    // ends whose remaining arcs have expired count as isolated
+    DynamicDiGraph ends;
+    ends.setSlidingWindow(WINDOW);
+    ends.addArc(0U, 1U, 1U);
+    ends.addArc(2U, 1U, 5U);
+    ends.removeArc(2U, 1U, 8U, true);
+    CHECK(ends.getConstructedGraphSize() == 1U);
+    CHECK(ends.getConstructedArcSize() == 0U);
+    replayed = replayDeltaByDelta(ends);
+    CHECK(replayed[8].vertices == std::vector<VertexIdentifier>{ 0U });
+    CHECK(replayed[8].arcs.empty());
+}
+
+void testSlidingWindow()
+{
+    testReviewScenarios();
+
+    const VertexIdentifier numIds = 12U;
+    for (auto seed : { 61U, 62U, 63U }) {
+        // full construction graph, with arc index, lightweight
+        for (auto mode : { 0U, 1U, 2U }) {
+            std::mt19937 gen(seed);
+            auto random = [&gen](std::size_t n) { return static_cast<std::size_t>(gen() % n); };
+            DynamicDiGraph dyGraph;
+            dyGraph.setSlidingWindow(WINDOW);
+            dyGraph.useArcIndex(mode == 1U);
+            dyGraph.useLightweightConstruction(mode == 2U);
+            WindowMirror mirror(numIds);
+            std::vector<Snapshot> expected(1U);
+            for (DynamicTime t = 1U; t <= 200U; t++) {
+                auto numOps = 1U + random(4U);
+                for (auto i = 0U; i < numOps; i++) {
+                    VertexIdentifier tail = random(numIds);
+                    VertexIdentifier head = random(numIds);
+                    auto op = random(10U);
+                    if (op == 0U && mirror.present[tail]) {
+                        dyGraph.removeVertex(tail, t);
+                        mirror.removeVertex(tail);
+                    } else if (op < 5U && !mirror.arcs.empty()) {
+                        // possibly an arc all copies of which have expired
+                        auto a = mirror.arcs[random(mirror.arcs.size())];
+                        bool removeIsolatedEnds = random(4U) == 0U;
+                        dyGraph.removeArc(a.tail, a.head, t, removeIsolatedEnds);
+                        mirror.removeArc(a.tail, a.head, t, removeIsolatedEnds);
+                    } else {
+                        if (op < 8U && !mirror.arcs.empty()) {
+                            // multi-arc
+                            auto a = mirror.arcs[random(mirror.arcs.size())];
+                            tail = a.tail;
+                            head = a.head;
+                        }
+                        dyGraph.addArc(tail, head, t);
+                        mirror.present[tail] = true;
+                        mirror.present[head] = true;
+                        mirror.arcs.push_back({ tail, head, t });
+                    }
+                }
+                CHECK(dyGraph.getConstructedArcSize() == mirror.snapshotAt(t).arcs.size());
+                expected.push_back(mirror.snapshotAt(t));
+            }
+            checkWindowedLog(dyGraph, expected);
+        }
+    }
+}
+
+}